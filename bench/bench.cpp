@@ -0,0 +1,456 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "container/container.h"
+#include "container/allocators/skip_list_arena.h"
+#include "container/unrolled_container.h"
+#include "container/indexed_container.h"
+#include "normalized_key.h"
+
+// Простые замеры времени для сравнения аллокаторов и режимов контейнера.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Не дает компилятору выбросить результаты поиска
+volatile std::int64_t benchmark_sink = 0;
+
+template <typename F>
+double measure_ms(F&& body) {
+    const auto start = Clock::now();
+    body();
+    const auto stop = Clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+void report(const std::string& name, double ms, std::size_t ops) {
+    std::cout << std::left << std::setw(44) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(2) << ms << " ms"
+              << std::setw(10) << std::setprecision(1) << (ms * 1e6 / static_cast<double>(ops)) << " ns/op"
+              << std::endl;
+}
+
+std::vector<std::int64_t> random_keys(std::size_t count, std::uint64_t seed) {
+    std::mt19937_64 gen(seed);
+    std::vector<std::int64_t> keys(count);
+    for (auto& key : keys) {
+        key = static_cast<std::int64_t>(gen() >> 1);
+    }
+    return keys;
+}
+
+template <typename ContainerType>
+void bench_container(const std::string& name, std::size_t count) {
+    const auto keys = random_keys(count, 42);
+    const auto churn = random_keys(count, 7);
+
+    ContainerType c;
+    report(name + " insert", measure_ms([&] {
+        for (auto key : keys) {
+            c.push_back(key);
+        }
+    }), count);
+
+    // Скользящее окно: удаляем минимальный элемент и вставляем новый
+    report(name + " erase+insert churn", measure_ms([&] {
+        for (auto key : churn) {
+            c.pop_front();
+            c.push_back(key);
+        }
+    }), count);
+
+    std::int64_t checksum = 0;
+    report(name + " find", measure_ms([&] {
+        for (auto key : churn) {
+            auto it = c.find(key);
+            if (it != c.end()) checksum ^= *it;
+        }
+    }), count);
+
+    report(name + " scan", measure_ms([&] {
+        for (auto value : c) {
+            checksum ^= value;
+        }
+    }), c.size());
+
+    report(name + " clear", measure_ms([&] {
+        c.clear();
+    }), count);
+    benchmark_sink = checksum;
+}
+
+// 200-байтовая запись с 64-битным ключом для сравнения раскладок узла
+struct Record {
+    std::int64_t timestamp;
+    char payload[192];
+
+    bool operator<(const Record& other) const noexcept { return timestamp < other.timestamp; }
+    bool operator==(const Record& other) const noexcept { return timestamp == other.timestamp; }
+};
+
+struct TimestampOf {
+    std::int64_t operator()(const Record& r) const noexcept { return r.timestamp; }
+};
+
+template <typename ContainerType, typename MakeProbe>
+void bench_records(const std::string& name, std::size_t count, MakeProbe make_probe) {
+    const auto keys = random_keys(count, 42);
+
+    ContainerType c;
+    report(name + " insert", measure_ms([&] {
+        for (auto key : keys) {
+            Record r{};
+            r.timestamp = key;
+            c.push_back(r);
+        }
+    }), count);
+
+    std::int64_t checksum = 0;
+    report(name + " find", measure_ms([&] {
+        for (auto key : keys) {
+            auto it = c.find(make_probe(key));
+            if (it != c.end()) checksum ^= it->timestamp;
+        }
+    }), count);
+    benchmark_sink = checksum;
+}
+
+template <typename ContainerType>
+void bench_strings(const std::string& name, const std::vector<std::string>& keys) {
+    ContainerType c;
+    report(name + " insert", measure_ms([&] {
+        for (const auto& key : keys) {
+            c.push_back(key);
+        }
+    }), keys.size());
+
+    std::int64_t checksum = 0;
+    report(name + " find", measure_ms([&] {
+        for (const auto& key : keys) {
+            auto it = c.find(key);
+            if (it != c.end()) checksum ^= static_cast<std::int64_t>(it->size());
+        }
+    }), keys.size());
+    benchmark_sink = checksum;
+}
+
+std::vector<std::string> string_keys(std::size_t count, const std::string& common_prefix) {
+    std::vector<std::string> keys;
+    keys.reserve(count);
+    for (auto key : random_keys(count, 9)) {
+        keys.push_back(common_prefix + std::to_string(key) + "/index.html");
+    }
+    return keys;
+}
+
+using CompositeKey = std::tuple<std::int32_t, std::string, double>;
+
+template <typename ContainerType>
+void bench_composite(const std::string& name, std::size_t count) {
+    std::vector<CompositeKey> keys;
+    keys.reserve(count);
+    for (auto key : random_keys(count, 5)) {
+        keys.emplace_back(static_cast<std::int32_t>(key % 16), "customer/region-" + std::to_string(key % 64),
+                          static_cast<double>(key % 100000) / 7.0);
+    }
+
+    ContainerType c;
+    report(name + " insert", measure_ms([&] {
+        for (const auto& key : keys) {
+            c.push_back(key);
+        }
+    }), count);
+
+    std::int64_t checksum = 0;
+    report(name + " find", measure_ms([&] {
+        for (const auto& key : keys) {
+            auto it = c.find(key);
+            if (it != c.end()) checksum ^= std::get<0>(*it);
+        }
+    }), count);
+    benchmark_sink = checksum;
+}
+
+// Скользящее окно с переиспользованием удаленных узлов.
+void bench_node_cache(std::size_t count) {
+    const auto keys = random_keys(count, 42);
+    const auto churn = random_keys(count, 7);
+    Container<std::int64_t> c;
+    c.set_node_cache_limit(1024);
+    for (auto key : keys) {
+        c.push_back(key);
+    }
+    report("node cache erase+insert churn", measure_ms([&] {
+        for (auto key : churn) {
+            c.pop_front();
+            c.push_back(key);
+        }
+    }), count);
+}
+
+void bench_reserve(std::size_t count) {
+    const auto keys = random_keys(count, 42);
+    Container<std::int64_t> c;
+    report("reserve", measure_ms([&] {
+        c.reserve(count);
+    }), count);
+    report("insert after reserve", measure_ms([&] {
+        for (auto key : keys) {
+            c.push_back(key);
+        }
+    }), count);
+}
+
+// Обход и поиск после долгой серии случайных вставок и удалений, до и после defragment().
+void bench_defragment(std::size_t count) {
+    const auto keys = random_keys(count, 42);
+    const auto churn = random_keys(count * 4, 7);
+    Container<std::int64_t> c;
+    for (auto key : keys) {
+        c.push_back(key);
+    }
+    // Удаляется случайный элемент, вставляется новый: узлы перемешиваются по куче
+    for (std::size_t i = 0; i < churn.size(); ++i) {
+        auto it = c.find(keys[churn[i] % count]);
+        if (it != c.end()) {
+            c.erase(it);
+        }
+        c.push_back(churn[i]);
+    }
+
+    std::int64_t checksum = 0;
+    auto scan_and_find = [&](const std::string& label) {
+        report("scan, " + label, measure_ms([&] {
+            for (auto value : c) checksum += value;
+        }), c.size());
+        report("find, " + label, measure_ms([&] {
+            for (std::size_t i = 0; i < count; ++i) {
+                auto it = c.find(churn[churn.size() - 1 - i]);
+                if (it != c.end()) checksum ^= *it;
+            }
+        }), count);
+    };
+    scan_and_find("fragmented");
+    report("defragment", measure_ms([&] { c.defragment(); }), c.size());
+    scan_and_find("defragmented");
+    benchmark_sink = checksum;
+}
+
+// Вставки рядом с предыдущей: с подсказкой (finger search) и без.
+void bench_hinted_insert(std::size_t count) {
+    Container<std::int64_t> hinted;
+    Container<std::int64_t> unhinted;
+    for (std::size_t i = 0; i < count; ++i) {
+        hinted.push_back(static_cast<std::int64_t>(i) * 2);
+        unhinted.push_back(static_cast<std::int64_t>(i) * 2);
+    }
+    report("local insert, hint = previous", measure_ms([&] {
+        auto hint = hinted.cbegin();
+        for (std::size_t i = 0; i < count; ++i) {
+            hint = hinted.insert(hint, static_cast<std::int64_t>(i) * 2 + 1);
+        }
+    }), count);
+    report("local insert, no usable hint", measure_ms([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            unhinted.insert(unhinted.cbegin(), static_cast<std::int64_t>(i) * 2 + 1);
+        }
+    }), count);
+
+    // Подсказка правее позиции: поиск назад по prev (find_left_anchor)
+    Container<std::int64_t> descending;
+    for (std::size_t i = 0; i < count; ++i) {
+        descending.push_back(static_cast<std::int64_t>(i) * 2);
+    }
+    report("local insert, descending, hint = previous", measure_ms([&] {
+        auto hint = descending.cend();
+        for (std::size_t i = count; i-- > 0;) {
+            hint = descending.insert(hint, static_cast<std::int64_t>(i) * 2 + 1);
+        }
+    }), count);
+}
+
+// Возрастающие метки времени через push_back и убывающие через push_front.
+void bench_monotonic(std::size_t count) {
+    Container<std::int64_t> c;
+    report("monotonic push_back", measure_ms([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            c.push_back(static_cast<std::int64_t>(i));
+        }
+    }), count);
+    report("monotonic push_front", measure_ms([&] {
+        for (std::size_t i = 1; i <= count; ++i) {
+            c.push_front(-static_cast<std::int64_t>(i));
+        }
+    }), count);
+}
+
+// Пакетный поиск по отсортированным ключам и слияние серии: курсор против find/insert.
+void bench_cursor(std::size_t count) {
+    Container<std::int64_t> c;
+    for (std::size_t i = 0; i < count; ++i) {
+        c.push_back(static_cast<std::int64_t>(i) * 2);
+    }
+
+    std::int64_t checksum = 0;
+    report("sorted batch find", measure_ms([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            auto it = c.find(static_cast<std::int64_t>(i) * 2);
+            if (it != c.end()) checksum ^= *it;
+        }
+    }), count);
+    report("sorted batch find, cursor", measure_ms([&] {
+        auto cursor = c.cursor();
+        for (std::size_t i = 0; i < count; ++i) {
+            auto it = cursor.find(static_cast<std::int64_t>(i) * 2);
+            if (it != c.end()) checksum ^= *it;
+        }
+    }), count);
+
+    Container<std::int64_t> merged = c;
+    report("merge sorted run, cursor", measure_ms([&] {
+        auto cursor = merged.cursor();
+        for (std::size_t i = 0; i < count; ++i) {
+            cursor.insert(static_cast<std::int64_t>(i) * 2 + 1);
+        }
+    }), count);
+    benchmark_sink = checksum;
+}
+
+// Объем анонимной памяти процесса на прозрачных огромных страницах (Linux).
+std::string anon_huge_pages() {
+    std::ifstream smaps("/proc/self/smaps_rollup");
+    std::string line;
+    while (std::getline(smaps, line)) {
+        if (line.rfind("AnonHugePages:", 0) == 0) {
+            return line.substr(line.find_first_not_of(' ', 14));
+        }
+    }
+    return "n/a";
+}
+
+// Поиск в большом контейнере на SkipListArena с обычными и огромными страницами.
+void bench_huge_pages(PageBacking backing, std::size_t count) {
+    const auto keys = random_keys(count, 42);
+    const std::string label = backing == PageBacking::HugePages ? "huge pages" : "4K pages";
+
+    Container<std::int64_t, SkipListArena<std::int64_t>> c{
+        backing == PageBacking::HugePages ? make_huge_page_arena<std::int64_t>()
+                                          : SkipListArena<std::int64_t>(SkipListArenaResource::MAX_SLAB_SIZE)};
+    report("insert, " + label, measure_ms([&] {
+        for (auto key : keys) {
+            c.push_back(key);
+        }
+    }), count);
+
+    std::int64_t checksum = 0;
+    const auto probes = random_keys(std::min<std::size_t>(count, 2000000), 7);
+    report("find, " + label, measure_ms([&] {
+        for (std::size_t i = 0; i < probes.size(); ++i) {
+            auto it = c.find(keys[static_cast<std::size_t>(probes[i]) % count]);
+            if (it != c.end()) checksum ^= *it;
+        }
+    }), probes.size());
+    std::cout << "  AnonHugePages: " << anon_huge_pages() << ", arena slabs requested as huge pages: "
+              << (c.get_allocator().resource()->huge_page_bytes() >> 20) << " MiB" << std::endl;
+    benchmark_sink = checksum;
+}
+
+// Задержка поиска в зависимости от порога HotTowerArena (16 - арена выключена).
+// Эффект порядка шума между запусками, поэтому контейнеры с разными порогами
+// строятся из одних ключей, замеры идут по кругу и печатается медиана раундов.
+// Отдельный запуск: ./list_container_bench 200000 0, строки "find, hot towers".
+void bench_hot_towers(const std::vector<int>& hot_levels, std::size_t count, int rounds) {
+    const auto keys = random_keys(count, 42);
+
+    std::vector<Container<std::int64_t>> containers(hot_levels.size());
+    for (std::size_t i = 0; i < hot_levels.size(); ++i) {
+        containers[i].set_hot_tower_level(hot_levels[i]);
+        for (auto key : keys) {
+            containers[i].push_back(key);
+        }
+    }
+
+    std::vector<std::vector<double>> times(hot_levels.size());
+    std::int64_t checksum = 0;
+    for (int round = 0; round < rounds; ++round) {
+        for (std::size_t i = 0; i < hot_levels.size(); ++i) {
+            times[i].push_back(measure_ms([&] {
+                for (auto key : keys) {
+                    auto it = containers[i].find(key);
+                    if (it != containers[i].end()) checksum ^= *it;
+                }
+            }));
+        }
+    }
+    for (std::size_t i = 0; i < hot_levels.size(); ++i) {
+        std::sort(times[i].begin(), times[i].end());
+        report("find, hot towers from level " + std::to_string(hot_levels[i]) + ", median of "
+                   + std::to_string(rounds),
+               times[i][times[i].size() / 2], count);
+    }
+    benchmark_sink = checksum;
+}
+
+} // namespace
+
+// Запуск: ./list_container_bench [элементов] [элементов для огромных страниц, 0 - пропустить]
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? static_cast<std::size_t>(std::stoull(argv[1])) : 200000;
+    const std::size_t huge_count = argc > 2 ? static_cast<std::size_t>(std::stoull(argv[2])) : 10000000;
+    std::cout << "Elements: " << count << std::endl;
+
+    bench_container<Container<std::int64_t>>("std::allocator", count);
+    bench_container<Container<std::int64_t, SkipListArena<std::int64_t>>>("SkipListArena", count);
+    bench_reserve(count);
+    bench_node_cache(count);
+    bench_defragment(count);
+    bench_hinted_insert(count);
+    bench_monotonic(count);
+    bench_cursor(count);
+    bench_container<ForwardContainer<std::int64_t>>("ForwardContainer", count);
+    bench_container<CachedLinkContainer<std::int64_t>>("CachedLinkContainer", count);
+    bench_container<IndexedContainer<std::int64_t>>("IndexedContainer", count);
+    bench_container<UnrolledContainer<std::int64_t>>("UnrolledContainer", count);
+
+    bench_records<Container<Record>>("Container<Record>", count, [](std::int64_t key) {
+        Record r{};
+        r.timestamp = key;
+        return r;
+    });
+    bench_records<SplitKeyContainer<Record, TimestampOf>>("SplitKeyContainer<Record>", count,
+                                                          [](std::int64_t key) { return key; });
+
+    const auto paths = string_keys(count, "/");
+    bench_strings<Container<std::string>>("string prefixes, paths", paths);
+    using PlainStrings = Container<std::string, std::allocator<std::string>, true, PlainValueKey<std::string>>;
+    bench_strings<PlainStrings>("plain strings, paths", paths);
+    const auto urls = string_keys(count, "https://example.com/");
+    bench_strings<Container<std::string>>("string prefixes, shared 20-byte prefix", urls);
+    bench_strings<PlainStrings>("plain strings, shared 20-byte prefix", urls);
+
+    bench_composite<Container<CompositeKey>>("tuple operator<", count);
+    bench_composite<Container<CompositeKey, std::allocator<CompositeKey>, true, NormalizedKey<CompositeKey>>>(
+        "tuple normalized memcmp", count);
+    // Коды в ~32 байта обрезаны: равные первые 30 байт сравниваются через operator<
+    bench_composite<Container<CompositeKey, std::allocator<CompositeKey>, true, NormalizedKey<CompositeKey, 30>>>(
+        "tuple normalized memcmp, truncated 30-byte codes", count);
+
+    bench_hot_towers({16, 8, 4, 2}, count, 5);
+
+    if (huge_count > 0) {
+        std::cout << "Elements: " << huge_count << std::endl;
+        bench_huge_pages(PageBacking::Heap, huge_count);
+        bench_huge_pages(PageBacking::HugePages, huge_count);
+    }
+
+    return 0;
+}
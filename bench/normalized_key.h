@@ -0,0 +1,206 @@
+// bench/normalized_key.h
+#ifndef BENCH_NORMALIZED_KEY_H
+#define BENCH_NORMALIZED_KEY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>     // Для std::memcpy и std::memcmp
+#include <limits>
+#include <memory>      // Для std::addressof
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Эксперимент для bench: политика ключа с кодами, сравниваемыми memcmp. В
+// библиотеку не входит - на составных ключах она оказалась медленнее operator<.
+
+// Кодирование ключей в байты с сохранением порядка: для любых a и b
+// a < b  <=>  encode(a) < encode(b) при побайтовом (memcmp) сравнении.
+// KeyEncoder<T>::append(out, value) дописывает код value в конец out (любой
+// приемник байтов с push_back(char), например std::string).
+//   - беззнаковые целые: big-endian;
+//   - знаковые целые: big-endian с инвертированным знаковым битом;
+//   - float/double: знаковый бит инвертируется у положительных, все биты - у
+//     отрицательных; -0.0 кодируется как +0.0. NaN не поддерживается;
+//   - std::string: байт 0x00 экранируется как 0x00 0xFF, конец - 0x00 0x00,
+//     поэтому строка-префикс меньше продолжения и в составе кортежа;
+//   - std::pair и std::tuple: коды элементов подряд.
+template <typename T, typename = void>
+struct KeyEncoder;
+
+namespace key_encoding_detail {
+
+template <typename Out, typename U>
+void append_big_endian(Out& out, U bits) {
+    for (int shift = std::numeric_limits<U>::digits - 8; shift >= 0; shift -= 8) {
+        out.push_back(static_cast<char>(static_cast<unsigned char>(bits >> shift)));
+    }
+}
+
+} // namespace key_encoding_detail
+
+template <typename T>
+struct KeyEncoder<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>> {
+    template <typename Out>
+    static void append(Out& out, T value) {
+        using Unsigned = std::make_unsigned_t<T>;
+        Unsigned bits = static_cast<Unsigned>(value);
+        if constexpr (std::is_signed_v<T>) {
+            bits ^= Unsigned{1} << (std::numeric_limits<Unsigned>::digits - 1);
+        }
+        key_encoding_detail::append_big_endian(out, bits);
+    }
+};
+
+template <>
+struct KeyEncoder<bool> {
+    template <typename Out>
+    static void append(Out& out, bool value) {
+        out.push_back(value ? '\1' : '\0');
+    }
+};
+
+template <typename T>
+struct KeyEncoder<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+    static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Only IEEE-754 float and double are supported");
+    using Bits = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+
+    template <typename Out>
+    static void append(Out& out, T value) {
+        if (value == T(0)) {
+            value = T(0); // -0.0 == +0.0
+        }
+        Bits bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        const Bits sign = Bits{1} << (sizeof(Bits) * 8 - 1);
+        bits = (bits & sign) ? ~bits : (bits | sign);
+        key_encoding_detail::append_big_endian(out, bits);
+    }
+};
+
+template <>
+struct KeyEncoder<std::string> {
+    template <typename Out>
+    static void append(Out& out, const std::string& value) {
+        for (char c : value) {
+            out.push_back(c);
+            if (c == '\0') {
+                out.push_back('\xff');
+            }
+        }
+        out.push_back('\0');
+        out.push_back('\0');
+    }
+};
+
+template <typename First, typename Second>
+struct KeyEncoder<std::pair<First, Second>> {
+    template <typename Out>
+    static void append(Out& out, const std::pair<First, Second>& value) {
+        KeyEncoder<First>::append(out, value.first);
+        KeyEncoder<Second>::append(out, value.second);
+    }
+};
+
+template <typename... Ts>
+struct KeyEncoder<std::tuple<Ts...>> {
+    template <typename Out>
+    static void append(Out& out, const std::tuple<Ts...>& value) {
+        std::apply([&out](const Ts&... parts) { (KeyEncoder<Ts>::append(out, parts), ...); }, value);
+    }
+};
+
+template <typename T>
+std::string encode_key(const T& value) {
+    std::string out;
+    KeyEncoder<T>::append(out, value);
+    return out;
+}
+
+// Нормализованный ключ: значение один раз при вставке кодируется в байты,
+// порядок которых совпадает с порядком значений (см. KeyEncoder выше), и поиск
+// сравнивает коды через memcmp вместо operator< типа T. Рассчитано на составные
+// ключи (кортежи чисел и строк), но выигрыш пока не показан: в bench на 1M
+// кортежей (int32, string, double) find медленнее operator< на 12-18%, insert -
+// на 6-17% (разброс между прогонами). Узел больше на Capacity + 2 байт.
+//
+// Код хранится в узле без аллокаций, первые Capacity байт. Если коды совпали
+// целиком, а хотя бы один был обрезан, порядок решает operator< самих значений,
+// и сравнение становится дороже обычного. Capacity = 46 (48 байт вместе с
+// длиной) вмещает int32, double и строку до ~30 символов.
+template <std::size_t Capacity>
+struct NormalizedBytes {
+    static_assert(Capacity < 256, "NormalizedBytes keeps its length in one byte");
+
+    std::uint8_t size = 0;
+    bool truncated = false;
+    unsigned char bytes[Capacity];
+
+    void push_back(char c) noexcept {
+        if (size == Capacity) {
+            truncated = true;
+            return;
+        }
+        bytes[size++] = static_cast<unsigned char>(c);
+    }
+
+    // <0, 0, >0, как memcmp; 0 - коды не различаются в сохраненных байтах.
+    static int compare(const NormalizedBytes& a, const NormalizedBytes& b) noexcept {
+        const int common = std::memcmp(a.bytes, b.bytes, std::min(a.size, b.size));
+        if (common != 0) {
+            return common;
+        }
+        return static_cast<int>(a.size) - static_cast<int>(b.size);
+    }
+};
+
+template <typename T, std::size_t Capacity = 46, typename Encoder = KeyEncoder<T>>
+struct NormalizedKey {
+    using Bytes = NormalizedBytes<Capacity>;
+
+    struct Probe {
+        Bytes bytes;
+        const T* key;
+    };
+
+    using key_type = T;
+    using stored_key = Bytes;
+    using probe = Probe;
+    using link_key = void;
+    static constexpr bool VALUE_OUT_OF_LINE = false;
+    static constexpr bool HETEROGENEOUS_LOOKUP = false; // Код строится из key_type
+    static constexpr bool NATURAL_ORDER_ONLY = true;
+
+    static Bytes encode(const T& value) {
+        Bytes out;
+        Encoder::append(out, value);
+        return out;
+    }
+
+    static const key_type& key(const T& value) noexcept { return value; }
+    static stored_key store(const T& value) { return encode(value); }
+    static probe make_probe(const key_type& key) { return {encode(key), std::addressof(key)}; }
+    static probe node_probe(const stored_key& stored, const T& value) noexcept {
+        return {stored, std::addressof(value)};
+    }
+
+    template <typename Compare>
+    static bool less(const Compare& comp, const stored_key& stored, const T& value, const probe& p) {
+        const int order = Bytes::compare(stored, p.bytes);
+        if (order != 0 || !(stored.truncated || p.bytes.truncated)) {
+            return order < 0;
+        }
+        return comp(value, *p.key);
+    }
+
+    template <typename Compare>
+    static bool equal(const Compare& comp, const stored_key& stored, const T& value, const probe& p) {
+        if (Bytes::compare(stored, p.bytes) != 0) {
+            return false;
+        }
+        return !(stored.truncated || p.bytes.truncated) || (!comp(value, *p.key) && !comp(*p.key, value));
+    }
+};
+
+#endif // BENCH_NORMALIZED_KEY_H
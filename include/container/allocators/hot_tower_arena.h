@@ -0,0 +1,142 @@
+// container/allocators/hot_tower_arena.h
+#ifndef CONTAINER_ALLOCATORS_HOT_TOWER_ARENA_H
+#define CONTAINER_ALLOCATORS_HOT_TOWER_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <algorithm>
+#include <utility>
+
+// Отдельный непрерывный регион для высоких узлов Skip List. Верхние уровни
+// проходятся при каждом find/insert, и если их узлы лежат плотно и выровнены
+// по кэш-линиям, верх списка помещается в L1/L2, а не разбросан по куче.
+// На практике промахи на нижних уровнях дороже, и выигрыш мал (несколько
+// процентов на 200k, см. bench_hot_towers), поэтому арена выключена по умолчанию.
+//
+// Блоки нарезаются целыми кэш-линиями из слэбов, которые берутся у аллокатора
+// контейнера; освобожденные блоки уходят в свободный список своего размера в линиях.
+// Арена не хранит копию аллокатора (иначе SkipListArena перестала бы быть
+// "эксклюзивной"), поэтому аллокатор передается в allocate() и release().
+class HotTowerArena {
+public:
+    static constexpr std::size_t CACHE_LINE = 64;
+    static constexpr std::size_t MAX_BLOCK_LINES = 16; // Более крупные узлы идут мимо арены
+    static constexpr std::size_t FIRST_SLAB_LINES = 64; // 4 KiB
+    static constexpr std::size_t MAX_SLAB_LINES = 4096; // 256 KiB
+
+    HotTowerArena() noexcept :
+        slabs(nullptr),
+        bump_current(nullptr),
+        bump_end(nullptr),
+        next_slab_lines(FIRST_SLAB_LINES),
+        free_lists() {}
+
+    HotTowerArena(HotTowerArena&& other) noexcept : HotTowerArena() {
+        swap(other);
+    }
+
+    HotTowerArena(const HotTowerArena&) = delete;
+    HotTowerArena& operator=(const HotTowerArena&) = delete;
+    HotTowerArena& operator=(HotTowerArena&&) = delete;
+
+    static constexpr bool fits(std::size_t bytes) noexcept {
+        return bytes <= MAX_BLOCK_LINES * CACHE_LINE;
+    }
+
+    bool empty() const noexcept {
+        return slabs == nullptr;
+    }
+
+    template <typename Alloc>
+    void* allocate(std::size_t bytes, Alloc& alloc) {
+        const std::size_t lines = lines_for(bytes);
+        if (free_lists[lines] != nullptr) {
+            FreeBlock* block = free_lists[lines];
+            free_lists[lines] = block->next;
+            return block;
+        }
+
+        if (static_cast<std::size_t>(bump_end - bump_current) < lines * CACHE_LINE) {
+            add_slab(std::max(next_slab_lines, lines + 1), alloc);
+        }
+        void* block = bump_current;
+        bump_current += lines * CACHE_LINE;
+        return block;
+    }
+
+    void deallocate(void* p, std::size_t bytes) noexcept {
+        const std::size_t lines = lines_for(bytes);
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        block->next = free_lists[lines];
+        free_lists[lines] = block;
+    }
+
+    // Возвращает все слэбы аллокатору. Все выданные блоки становятся недействительными.
+    template <typename Alloc>
+    void release(Alloc& alloc) noexcept {
+        using Unit = typename std::allocator_traits<Alloc>::value_type;
+        while (slabs != nullptr) {
+            SlabHeader* slab = slabs;
+            slabs = slab->next;
+            std::allocator_traits<Alloc>::deallocate(alloc, static_cast<Unit*>(slab->memory), slab->units);
+        }
+        bump_current = nullptr;
+        bump_end = nullptr;
+        next_slab_lines = FIRST_SLAB_LINES;
+        std::fill(std::begin(free_lists), std::end(free_lists), nullptr);
+    }
+
+    void swap(HotTowerArena& other) noexcept {
+        using std::swap;
+        swap(slabs, other.slabs);
+        swap(bump_current, other.bump_current);
+        swap(bump_end, other.bump_end);
+        swap(next_slab_lines, other.next_slab_lines);
+        swap(free_lists, other.free_lists);
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    // Лежит в первой линии слэба.
+    struct SlabHeader {
+        SlabHeader* next;
+        void* memory;
+        std::size_t units;
+    };
+
+    SlabHeader* slabs;
+    unsigned char* bump_current;
+    unsigned char* bump_end;
+    std::size_t next_slab_lines;
+    FreeBlock* free_lists[MAX_BLOCK_LINES + 1]; // Индекс - размер блока в линиях
+
+    static std::size_t lines_for(std::size_t bytes) noexcept {
+        return (bytes + CACHE_LINE - 1) / CACHE_LINE;
+    }
+
+    // Слэб из lines линий плюс линия под заголовок и запас на выравнивание.
+    template <typename Alloc>
+    void add_slab(std::size_t lines, Alloc& alloc) {
+        using Unit = typename std::allocator_traits<Alloc>::value_type;
+        const std::size_t bytes = (lines + 2) * CACHE_LINE;
+        const std::size_t units = (bytes + sizeof(Unit) - 1) / sizeof(Unit);
+        Unit* memory = std::allocator_traits<Alloc>::allocate(alloc, units);
+
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(memory);
+        unsigned char* aligned = reinterpret_cast<unsigned char*>(memory)
+            + (CACHE_LINE - address % CACHE_LINE) % CACHE_LINE;
+
+        SlabHeader* header = ::new (static_cast<void*>(aligned)) SlabHeader{slabs, memory, units};
+        slabs = header;
+        bump_current = aligned + CACHE_LINE;
+        bump_end = bump_current + lines * CACHE_LINE;
+        next_slab_lines = std::min(next_slab_lines * 2, MAX_SLAB_LINES);
+    }
+};
+
+#endif // CONTAINER_ALLOCATORS_HOT_TOWER_ARENA_H
@@ -0,0 +1,113 @@
+// container/allocators/huge_pages.h
+#ifndef CONTAINER_ALLOCATORS_HUGE_PAGES_H
+#define CONTAINER_ALLOCATORS_HUGE_PAGES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+// Откуда берутся слэбы арены.
+enum class PageBacking {
+    Heap,      // ::operator new, обычные страницы по 4 KiB
+    HugePages  // mmap с огромными страницами, если ОС их дает
+};
+
+// Как запрошена память слэба.
+enum class HugePageKind {
+    None,        // Обычные страницы (не Linux или огромные страницы недоступны)
+    Transparent, // Регион выровнен по 2 MiB и помечен madvise(MADV_HUGEPAGE); покрытие не гарантировано
+    HugeTlb      // Заранее зарезервированные страницы MAP_HUGETLB
+};
+
+// Регионы под узлы на огромных страницах. На большом Skip List узлы разбросаны
+// по тысячам страниц по 4 KiB, и каждый переход по связи - это еще и промах TLB;
+// страница в 2 MiB покрывает в 512 раз больше узлов.
+//
+// Сначала пробуется прозрачная поддержка (THP): регион выравнивается по 2 MiB
+// и помечается madvise(MADV_HUGEPAGE). Если ядро ее не поддерживает, берутся
+// страницы MAP_HUGETLB, если они есть, иначе остаются обычные страницы mmap.
+class HugePageMemory {
+public:
+    static constexpr std::size_t HUGE_PAGE_SIZE = std::size_t{2} * 1024 * 1024;
+
+    struct Region {
+        void* memory;
+        std::size_t bytes; // Кратно HUGE_PAGE_SIZE
+        HugePageKind kind;
+    };
+
+    static constexpr std::size_t round_up(std::size_t bytes) noexcept {
+        return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    }
+
+    // Бросает std::bad_alloc, если память не выделена.
+    static Region allocate(std::size_t bytes) {
+        const std::size_t size = round_up(bytes == 0 ? 1 : bytes);
+#if defined(__linux__)
+        if (void* memory = map_transparent(size)) {
+            return Region{memory, size, HugePageKind::Transparent};
+        }
+#if defined(MAP_HUGETLB)
+        void* hugetlb = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (hugetlb != MAP_FAILED) {
+            return Region{hugetlb, size, HugePageKind::HugeTlb};
+        }
+#endif
+        void* memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        return Region{memory, size, HugePageKind::None};
+#else
+        return Region{::operator new(size, std::align_val_t(alignof(std::max_align_t))), size, HugePageKind::None};
+#endif
+    }
+
+    static void deallocate(const Region& region) noexcept {
+#if defined(__linux__)
+        ::munmap(region.memory, region.bytes);
+#else
+        ::operator delete(region.memory, std::align_val_t(alignof(std::max_align_t)));
+#endif
+    }
+
+private:
+#if defined(__linux__)
+    // mmap с запасом в одну огромную страницу и обрезка до границы 2 MiB:
+    // ядро собирает огромную страницу только из выровненного диапазона.
+    static void* map_transparent(std::size_t size) noexcept {
+#if defined(MADV_HUGEPAGE)
+        const std::size_t padded = size + HUGE_PAGE_SIZE;
+        void* raw = ::mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            return nullptr;
+        }
+        const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(raw);
+        const std::uintptr_t aligned = (begin + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        if (aligned > begin) {
+            ::munmap(raw, aligned - begin);
+        }
+        const std::uintptr_t tail = begin + padded - (aligned + size);
+        if (tail > 0) {
+            ::munmap(reinterpret_cast<void*>(aligned + size), tail);
+        }
+        void* memory = reinterpret_cast<void*>(aligned);
+        if (::madvise(memory, size, MADV_HUGEPAGE) != 0) {
+            ::munmap(memory, size);
+            return nullptr;
+        }
+        return memory;
+#else
+        (void)size;
+        return nullptr;
+#endif
+    }
+#endif
+};
+
+#endif // CONTAINER_ALLOCATORS_HUGE_PAGES_H
@@ -0,0 +1,362 @@
+// container/allocators/skip_list_arena.h
+#ifndef CONTAINER_ALLOCATORS_SKIP_LIST_ARENA_H
+#define CONTAINER_ALLOCATORS_SKIP_LIST_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#include "container/allocators/huge_pages.h"
+
+// Ресурс арены: узлы нарезаются из больших слэбов, освобожденные блоки уходят
+// в интрузивный свободный список своего класса размера. Классы размеров идут
+// с шагом GRANULE байт, поэтому каждая высота башни Container попадает в свой класс.
+// Каждый следующий слэб вдвое больше предыдущего (до MAX_SLAB_SIZE), так что
+// число слэбов растет логарифмически и массовое освобождение остается дешевым.
+// С PageBacking::HugePages слэбы (не меньше 2 MiB) берутся у HugePageMemory.
+// Блоки больше slab_size/4 или с выравниванием больше max_align_t выделяются
+// отдельно, но тоже учитываются (список large_blocks) и возвращаются в release().
+// Не потокобезопасен: один ресурс рассчитан на один контейнер (или один поток).
+class SkipListArenaResource {
+public:
+    static constexpr std::size_t GRANULE = alignof(void*);
+    static constexpr std::size_t MAX_BLOCK_ALIGNMENT = alignof(std::max_align_t);
+    static constexpr std::size_t DEFAULT_SLAB_SIZE = 64 * 1024;
+    static constexpr std::size_t MAX_SLAB_SIZE = 16 * 1024 * 1024;
+
+    explicit SkipListArenaResource(std::size_t slab_size = DEFAULT_SLAB_SIZE,
+                                   PageBacking page_backing = PageBacking::Heap) :
+        backing(page_backing),
+        slab_bytes(backing == PageBacking::HugePages ? HugePageMemory::round_up(slab_size)
+                                                     : std::max(slab_size, std::size_t{1024})),
+        next_slab_bytes(slab_bytes),
+        bump_current(nullptr),
+        bump_end(nullptr),
+        large_blocks(nullptr),
+        bytes_in_use(0) {}
+
+    SkipListArenaResource(const SkipListArenaResource&) = delete;
+    SkipListArenaResource& operator=(const SkipListArenaResource&) = delete;
+
+    ~SkipListArenaResource() {
+        release();
+    }
+
+    void* allocate(std::size_t bytes, std::size_t alignment) {
+        if (!is_small(bytes, alignment)) {
+            return allocate_large(bytes, alignment);
+        }
+
+        const std::size_t size_class = class_index(bytes, alignment);
+        if (size_class < free_lists.size() && free_lists[size_class] != nullptr) {
+            FreeBlock* block = free_lists[size_class];
+            free_lists[size_class] = block->next;
+            bytes_in_use += class_bytes(size_class);
+            return block;
+        }
+
+        if (size_class >= free_lists.size()) {
+            free_lists.resize(size_class + 1, nullptr);
+        }
+        void* block = carve(class_bytes(size_class));
+        bytes_in_use += class_bytes(size_class);
+        return block;
+    }
+
+    void deallocate(void* p, std::size_t bytes, std::size_t alignment) noexcept {
+        if (p == nullptr) return;
+        if (!is_small(bytes, alignment)) {
+            LargeBlock* block = large_block_of(p, alignment);
+            unlink_large(block);
+            free_large(block);
+            return;
+        }
+
+        const std::size_t size_class = class_index(bytes, alignment);
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        block->next = free_lists[size_class];
+        free_lists[size_class] = block;
+        bytes_in_use -= class_bytes(size_class);
+    }
+
+    // Возвращает все слэбы разом. Все блоки, выданные ареной, становятся недействительными.
+    void release() noexcept {
+        for (const Slab& slab : slabs) {
+            free_slab(slab);
+        }
+        slabs.clear();
+        while (large_blocks != nullptr) {
+            LargeBlock* block = large_blocks;
+            large_blocks = block->next;
+            free_large(block);
+        }
+        next_slab_bytes = slab_bytes;
+        std::fill(free_lists.begin(), free_lists.end(), nullptr);
+        bump_current = nullptr;
+        bump_end = nullptr;
+        bytes_in_use = 0;
+    }
+
+    // Как release(), но оставляет самый большой (последний) слэб для повторного заполнения.
+    void reset() noexcept {
+        if (slabs.empty()) {
+            release();
+            return;
+        }
+        const Slab last = slabs.back();
+        slabs.pop_back();
+        release();
+        slabs.push_back(last);
+        next_slab_bytes = std::min(last.bytes * 2, std::max(MAX_SLAB_SIZE, slab_bytes));
+        bump_current = static_cast<unsigned char*>(last.memory);
+        bump_end = bump_current + last.bytes;
+    }
+
+    std::size_t slab_size() const noexcept { return slab_bytes; }
+    std::size_t slab_count() const noexcept { return slabs.size(); }
+    std::size_t large_block_count() const noexcept {
+        std::size_t count = 0;
+        for (const LargeBlock* block = large_blocks; block != nullptr; block = block->next) {
+            count++;
+        }
+        return count;
+    }
+    std::size_t bytes_allocated() const noexcept { return bytes_in_use; }
+    PageBacking page_backing() const noexcept { return backing; }
+
+    // Сколько байт слэбов запрошено на огромных страницах. Для hugetlb это так и есть,
+    // а madvise(MADV_HUGEPAGE) - только подсказка: ядро может оставить обычные страницы.
+    // Реальное покрытие видно по AnonHugePages в /proc/self/smaps_rollup.
+    std::size_t huge_page_bytes() const noexcept {
+        std::size_t bytes = 0;
+        for (const Slab& slab : slabs) {
+            if (slab.kind != HugePageKind::None) {
+                bytes += slab.bytes;
+            }
+        }
+        return bytes;
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    // Заголовок крупного блока, лежит перед ним самим.
+    struct LargeBlock {
+        LargeBlock* prev;
+        LargeBlock* next;
+        std::size_t bytes; // Вместе с заголовком
+        std::size_t alignment;
+        bool mapped; // Выделен HugePageMemory, а не operator new
+    };
+
+    struct Slab {
+        void* memory;
+        std::size_t bytes;
+        HugePageKind kind;
+        bool mapped; // Выделен HugePageMemory, а не operator new
+    };
+
+    PageBacking backing;
+    std::size_t slab_bytes;
+    std::size_t next_slab_bytes;
+    std::vector<Slab> slabs;
+    std::vector<FreeBlock*> free_lists; // Индекс - размер блока в GRANULE
+    unsigned char* bump_current;
+    unsigned char* bump_end;
+    LargeBlock* large_blocks;
+    std::size_t bytes_in_use;
+
+    bool is_small(std::size_t bytes, std::size_t alignment) const noexcept {
+        return alignment <= MAX_BLOCK_ALIGNMENT && bytes <= slab_bytes / 4;
+    }
+
+    static std::size_t class_index(std::size_t bytes, std::size_t alignment) noexcept {
+        const std::size_t step = std::max(alignment, GRANULE);
+        const std::size_t rounded = (std::max(bytes, sizeof(FreeBlock)) + step - 1) / step * step;
+        return rounded / GRANULE;
+    }
+
+    static std::size_t class_bytes(std::size_t size_class) noexcept {
+        return size_class * GRANULE;
+    }
+
+    // Блоки одного класса всегда выровнены по наибольшей степени двойки, делящей
+    // их размер, поэтому блок из свободного списка подходит любому запросу этого класса.
+    static std::size_t block_alignment(std::size_t block_bytes) noexcept {
+        return std::min(block_bytes & (~block_bytes + 1), MAX_BLOCK_ALIGNMENT);
+    }
+
+    // Заголовок занимает целое число выравниваний блока.
+    static std::size_t large_header_bytes(std::size_t alignment) noexcept {
+        const std::size_t step = std::max(alignment, alignof(LargeBlock));
+        return (sizeof(LargeBlock) + step - 1) / step * step;
+    }
+
+    static LargeBlock* large_block_of(void* p, std::size_t alignment) noexcept {
+        return reinterpret_cast<LargeBlock*>(static_cast<unsigned char*>(p) - large_header_bytes(alignment));
+    }
+
+    // Крупные блоки (регион defragment(), слэбы HotTowerArena, большие узлы)
+    // с HugePages тоже просятся на огромных страницах.
+    void* allocate_large(std::size_t bytes, std::size_t alignment) {
+        const std::size_t header = large_header_bytes(alignment);
+        const bool mapped = backing == PageBacking::HugePages && alignment <= MAX_BLOCK_ALIGNMENT;
+        std::size_t total = header + bytes;
+        void* memory = nullptr;
+        if (mapped) {
+            const HugePageMemory::Region region = HugePageMemory::allocate(total);
+            memory = region.memory;
+            total = region.bytes;
+        } else {
+            memory = ::operator new(total, std::align_val_t(std::max(alignment, alignof(LargeBlock))));
+        }
+        LargeBlock* block = ::new (memory) LargeBlock{nullptr, large_blocks, total, alignment, mapped};
+        if (large_blocks != nullptr) {
+            large_blocks->prev = block;
+        }
+        large_blocks = block;
+        return static_cast<unsigned char*>(memory) + header;
+    }
+
+    void unlink_large(LargeBlock* block) noexcept {
+        if (block->prev != nullptr) {
+            block->prev->next = block->next;
+        } else {
+            large_blocks = block->next;
+        }
+        if (block->next != nullptr) {
+            block->next->prev = block->prev;
+        }
+    }
+
+    static void free_large(LargeBlock* block) noexcept {
+        if (block->mapped) {
+            HugePageMemory::deallocate(HugePageMemory::Region{block, block->bytes, HugePageKind::None});
+        } else {
+            ::operator delete(block, std::align_val_t(std::max(block->alignment, alignof(LargeBlock))));
+        }
+    }
+
+    void* carve(std::size_t block_bytes) {
+        const std::size_t alignment = block_alignment(block_bytes);
+        std::size_t padding = bump_current == nullptr ? 0 :
+            (alignment - reinterpret_cast<std::uintptr_t>(bump_current) % alignment) % alignment;
+
+        if (bump_current == nullptr || static_cast<std::size_t>(bump_end - bump_current) < padding + block_bytes) {
+            slabs.reserve(slabs.size() + 1);
+            const Slab slab = new_slab(next_slab_bytes);
+            bump_current = static_cast<unsigned char*>(slab.memory);
+            bump_end = bump_current + slab.bytes;
+            slabs.push_back(slab);
+            next_slab_bytes = std::min(slab.bytes * 2, std::max(MAX_SLAB_SIZE, slab_bytes));
+            padding = 0;
+        }
+
+        void* block = bump_current + padding;
+        bump_current += padding + block_bytes;
+        return block;
+    }
+
+    Slab new_slab(std::size_t bytes) {
+        if (backing == PageBacking::HugePages) {
+            const HugePageMemory::Region region = HugePageMemory::allocate(bytes);
+            return Slab{region.memory, region.bytes, region.kind, true};
+        }
+        return Slab{::operator new(bytes, std::align_val_t(MAX_BLOCK_ALIGNMENT)), bytes, HugePageKind::None, false};
+    }
+
+    static void free_slab(const Slab& slab) noexcept {
+        if (slab.mapped) {
+            HugePageMemory::deallocate(HugePageMemory::Region{slab.memory, slab.bytes, slab.kind});
+        } else {
+            ::operator delete(slab.memory, std::align_val_t(MAX_BLOCK_ALIGNMENT));
+        }
+    }
+};
+
+// Аллокатор поверх SkipListArenaResource. Копии (включая rebind) разделяют один
+// ресурс; сконструированный по умолчанию аллокатор создает собственную арену.
+template <typename T>
+class SkipListArena {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    explicit SkipListArena(std::size_t slab_size = SkipListArenaResource::DEFAULT_SLAB_SIZE,
+                           PageBacking backing = PageBacking::Heap) :
+        arena(std::make_shared<SkipListArenaResource>(slab_size, backing)) {}
+
+    explicit SkipListArena(std::shared_ptr<SkipListArenaResource> resource) noexcept :
+        arena(std::move(resource)) {}
+
+    // Перемещение копирует: перемещенный контейнер должен сохранять рабочий аллокатор.
+    SkipListArena(const SkipListArena&) noexcept = default;
+    SkipListArena& operator=(const SkipListArena&) noexcept = default;
+
+    template <typename U>
+    SkipListArena(const SkipListArena<U>& other) noexcept : arena(other.resource()) {}
+
+    T* allocate(std::size_t n) {
+        if (n > std::allocator_traits<std::allocator<T>>::max_size(std::allocator<T>())) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        arena->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    // Сбрасывает арену целиком, если этот аллокатор - ее единственный владелец.
+    // Container использует это, чтобы не обходить узлы по одному в clear() и деструкторе.
+    bool release_if_exclusive() noexcept {
+        if (!is_exclusive()) {
+            return false;
+        }
+        arena->reset();
+        return true;
+    }
+
+    bool is_exclusive() const noexcept {
+        return arena.use_count() == 1;
+    }
+
+    // Копия контейнера получает собственную арену с тем же размером слэба и страницами.
+    SkipListArena select_on_container_copy_construction() const {
+        return SkipListArena(arena->slab_size(), arena->page_backing());
+    }
+
+    const std::shared_ptr<SkipListArenaResource>& resource() const noexcept {
+        return arena;
+    }
+
+    template <typename U>
+    bool operator==(const SkipListArena<U>& other) const noexcept {
+        return arena == other.resource();
+    }
+
+    template <typename U>
+    bool operator!=(const SkipListArena<U>& other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    std::shared_ptr<SkipListArenaResource> arena;
+};
+
+// Арена на огромных страницах для больших контейнеров: меньше промахов TLB при поиске.
+template <typename T>
+SkipListArena<T> make_huge_page_arena(std::size_t slab_size = HugePageMemory::HUGE_PAGE_SIZE) {
+    return SkipListArena<T>(slab_size, PageBacking::HugePages);
+}
+
+#endif // CONTAINER_ALLOCATORS_SKIP_LIST_ARENA_H
@@ -8,16 +8,64 @@
 #include <initializer_list>
 #include <type_traits>
 #include <algorithm>
+#include <functional> // Для std::less
+#include <utility> // Для std::pair
 #include <random>
 #include <chrono>
 #include <iostream>
+#include <memory_resource>
 
 #include "container/nodes/node.h"
-
-template <typename T, typename Allocator = std::allocator<T>>
+#include "container/nodes/node_pool.h"
+#include "container/allocators/hot_tower_arena.h"
+
+// Аллокатор умеет освободить всю свою память разом (например, SkipListArena).
+template <typename Alloc, typename = void>
+struct supports_bulk_release : std::false_type {};
+
+template <typename Alloc>
+struct supports_bulk_release<Alloc, std::void_t<decltype(std::declval<Alloc&>().release_if_exclusive()),
+                                                decltype(std::declval<const Alloc&>().is_exclusive())>>
+    : std::true_type {};
+
+// Шаги назад по prev в вставке с подсказкой не сравнивают ключи, поэтому тесты
+// считают их этим счетчиком (определяют CONTAINER_COUNT_PREV_STEPS до подключения).
+#ifdef CONTAINER_COUNT_PREV_STEPS
+inline std::size_t container_prev_steps = 0;
+#define CONTAINER_PREV_STEP() (++container_prev_steps)
+#else
+#define CONTAINER_PREV_STEP() ((void)0)
+#endif
+
+// Bidirectional == false включает односвязный режим: узлы не хранят prev,
+// итераторы становятся однонаправленными, back() берет последний узел из хвостов
+// уровней, а pop_back() ищет его предшественников спуском за O(log n).
+// KeyPolicy задает ключ поиска и раскладку узла, см. container/nodes/key_policy.h.
+// Compare упорядочивает ключи (по умолчанию std::less<key_type>, как в std::set).
+// find()/contains()/границы принимают ключи других типов, если Compare прозрачен
+// (std::less<> и т.п.) и сравнивает их с key_type; Container<std::string> ищет
+// по string_view и const char* и с обычным std::less (см. StringPrefixKey).
+// С другим Compare ValueKey<T> по умолчанию становится PlainValueKey<T> (KeyPolicyFor).
+// set_hot_tower_level() переносит узлы выше заданной высоты (и sentinel) в HotTowerArena.
+template <typename T, typename Allocator = std::allocator<T>, bool Bidirectional = true,
+          typename KeyPolicyParam = ValueKey<T>, typename Compare = std::less<typename KeyPolicyParam::key_type>>
 class Container {
+    using KeyPolicy = KeyPolicyFor<KeyPolicyParam, T, Compare>;
+    using BaseNode = NodeBase<Bidirectional, typename KeyPolicy::link_key>;
+    using ValueNode = Node<T, Bidirectional, KeyPolicy>;
+    using Storage = NodeStorage<T, Bidirectional, KeyPolicy>;
+    using Probe = typename KeyPolicy::probe;
+
+    static_assert(!KeyPolicy::NATURAL_ORDER_ONLY || IS_NATURAL_ORDER<Compare, typename KeyPolicy::key_type>,
+                  "This KeyPolicy encodes operator< order in the node; use PlainValueKey<T> with a custom Compare");
+
+    template <typename K>
+    static constexpr bool TRANSPARENT_LOOKUP = CAN_LOOK_UP_BY<KeyPolicy, Compare, K>;
+
 public:
     using value_type = T;
+    using key_type = typename KeyPolicy::key_type;
+    using key_compare = Compare;
     using allocator_type = Allocator;
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
@@ -29,14 +77,15 @@ public:
     template <bool IsConst>
     class Iterator {
     public:
-        using iterator_category = std::bidirectional_iterator_tag;
+        using iterator_category = std::conditional_t<Bidirectional, std::bidirectional_iterator_tag, std::forward_iterator_tag>;
         using value_type = Container::value_type;
         using difference_type = Container::difference_type;
         using pointer = std::conditional_t<IsConst, Container::const_pointer, Container::pointer>;
         using reference = std::conditional_t<IsConst, Container::const_reference, Container::reference>;
 
-        using NodeType = Node<value_type>;
-        using NodePointer = std::conditional_t<IsConst, const NodeType*, NodeType*>;
+        using NodeType = ValueNode;
+        using NodePointer = std::conditional_t<IsConst, const BaseNode*, BaseNode*>;
+        using ValueNodePointer = std::conditional_t<IsConst, const NodeType*, NodeType*>;
 
     private:
         NodePointer current_node;
@@ -57,24 +106,24 @@ public:
         }
 
         reference operator*() const {
-            if (!current_node || current_node->is_sentinel) {
+            if (!current_node || current_node->is_sentinel()) {
                 throw std::out_of_range("Dereferencing invalid iterator or sentinel.");
             }
-            return current_node->value;
+            return static_cast<ValueNodePointer>(current_node)->get();
         }
 
         pointer operator->() const {
-            if (!current_node || current_node->is_sentinel) {
+            if (!current_node || current_node->is_sentinel()) {
                 throw std::out_of_range("Dereferencing invalid iterator or sentinel.");
             }
-            return std::addressof(current_node->value);
+            return std::addressof(static_cast<ValueNodePointer>(current_node)->get());
         }
 
         Iterator& operator++() {
             if (!current_node) {
                 throw std::out_of_range("Incrementing null iterator.");
             }
-            current_node = current_node->next;
+            current_node = current_node->forward(0);
             return *this;
         }
 
@@ -84,7 +133,7 @@ public:
             return temp;
         }
 
-        Iterator& operator--() {
+        Iterator& operator--() requires Bidirectional {
             if (!current_node) {
                 throw std::out_of_range("Decrementing null iterator.");
             }
@@ -92,7 +141,7 @@ public:
             return *this;
         }
 
-        Iterator operator--(int) {
+        Iterator operator--(int) requires Bidirectional {
             Iterator temp = *this;
             --(*this);
             return temp;
@@ -111,16 +160,49 @@ public:
     using const_iterator = Iterator<true>;
 
 private:
-    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node<T>>;
+    // Узел и его башня выделяются одним блоком из Storage, последние узлы уровней -
+    // массивом указателей. Вся память контейнера идет через Allocator.
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Storage>;
+    using PointerAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<BaseNode*>;
+    using ValueAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
     NodeAllocator node_allocator;
+    [[no_unique_address]] Compare compare; // Пустой компаратор места не занимает
+
+    // Узлы можно не обходить, если деструкторы не нужны и арена принадлежит только контейнеру.
+    // Проверяется и сам узел: SplitKey хранит в нем копию ключа, у которой деструктор может быть.
+    static constexpr bool CAN_RELEASE_NODES_IN_BULK =
+        std::is_trivially_destructible_v<T> && std::is_trivially_destructible_v<ValueNode>
+        && supports_bulk_release<NodeAllocator>::value;
 
-    Node<T>* sentinel_node;
+    BaseNode* sentinel_node; // Не содержит T
     size_type num_elements;
 
     static constexpr int MAX_SKIP_LEVEL = 16;
-    Node<T>** skip_list_heads;
+    static_assert(MAX_SKIP_LEVEL == BaseNode::MAX_NODE_LEVEL, "Container and Node must agree on the tower height");
+    // level_tails[i] - последний узел уровня i (sentinel, если уровень пуст):
+    // push_back больших или равных back() значений пристегивается к ним без поиска.
+    BaseNode** level_tails;
     int current_max_level;
 
+    // Узлы с level >= min_hot_level лежат в hot_arena; MAX_SKIP_LEVEL - арена выключена.
+    HotTowerArena hot_arena;
+    int min_hot_level;
+
+    // Свободные блоки под узлы. reserved_levels - сколько из них выделено reserve()
+    // и еще не занято, по высотам башен; остальные - узлы, сохраненные при удалении
+    // (не больше cached_nodes_limit).
+    NodePool<Storage, MAX_SKIP_LEVEL> node_pool;
+    size_type reserved_levels[MAX_SKIP_LEVEL] = {};
+    size_type reserved_nodes = 0;
+    size_type cached_nodes_limit = 0;
+
+    // Регион, в который defragment() переложил узлы. Блоки в нем по одному не
+    // освобождаются: регион целиком возвращается аллокатору, когда в нем не
+    // остается живых узлов (compact_region_nodes == 0).
+    Storage* compact_region = nullptr;
+    size_type compact_region_units = 0;
+    size_type compact_region_nodes = 0;
+
     mutable std::mt19937 rng;
     mutable std::uniform_real_distribution<double> dist;
 
@@ -129,47 +211,82 @@ private:
             destroy_container_nodes();
         }
 
-        sentinel_node = allocate_and_construct_sentinel();
-        sentinel_node->next = sentinel_node;
-        sentinel_node->prev = sentinel_node;
+        allocate_sentinel_and_tails();
+        reset_skip_list();
 
-        num_elements = 0;
+        rng.seed(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+        dist = std::uniform_real_distribution<double>(0.0, 1.0);
+    }
+
+    void allocate_sentinel_and_tails() {
+        if (sentinel_node == nullptr) {
+            sentinel_node = allocate_and_construct_sentinel();
+        }
+
+        if (level_tails == nullptr) {
+            PointerAllocator pointer_allocator(node_allocator);
+            level_tails = std::allocator_traits<PointerAllocator>::allocate(pointer_allocator, MAX_SKIP_LEVEL);
+        }
+    }
 
-        if (skip_list_heads == nullptr) {
-             skip_list_heads = new Node<T>*[MAX_SKIP_LEVEL];
+    // Возвращает уже выделенные sentinel и хвосты уровней в состояние пустого списка.
+    void reset_skip_list() noexcept {
+        if constexpr (Bidirectional) {
+            sentinel_node->prev = sentinel_node;
         }
 
         for (int i = 0; i < MAX_SKIP_LEVEL; ++i) {
-            skip_list_heads[i] = sentinel_node;
-            sentinel_node->forward[i] = sentinel_node;
+            level_tails[i] = sentinel_node;
+            sentinel_node->forward(i) = sentinel_node;
         }
         current_max_level = 0;
-
-        rng.seed(std::chrono::high_resolution_clock::now().time_since_epoch().count());
-        dist = std::uniform_real_distribution<double>(0.0, 1.0);
+        num_elements = 0;
     }
 
-    void destroy_container_nodes() noexcept {
-        if (sentinel_node == nullptr) {
-            if (skip_list_heads != nullptr) {
-                delete[] skip_list_heads;
-                skip_list_heads = nullptr;
+    // Сбрасывает арену целиком (вместе с sentinel и хвостами уровней), если это возможно.
+    bool release_nodes_in_bulk() noexcept {
+        if constexpr (CAN_RELEASE_NODES_IN_BULK) {
+            if (node_allocator.is_exclusive()) {
+                // Горячая арена и регион defragment() возвращают свои блоки до сброса,
+                // остальные узлы (и крупные, мимо слэбов) SkipListArena освобождает сама
+                drain_node_pool();
+                hot_arena.release(node_allocator);
+                release_compact_region();
+                node_allocator.release_if_exclusive();
+                sentinel_node = nullptr;
+                level_tails = nullptr;
+                return true;
             }
-            return;
         }
+        return false;
+    }
 
-        Node<T>* current = sentinel_node->next;
+    void destroy_element_nodes() noexcept {
+        BaseNode* current = sentinel_node->forward(0);
         while (current != sentinel_node) {
-            Node<T>* next_node = current->next;
+            BaseNode* next_node = current->forward(0);
             destroy_and_deallocate_node(current);
             current = next_node;
         }
-        destroy_and_deallocate_node(sentinel_node);
-        sentinel_node = nullptr;
+    }
+
+    void destroy_container_nodes() noexcept {
+        if (sentinel_node != nullptr && !release_nodes_in_bulk()) {
+            destroy_element_nodes();
+            destroy_and_deallocate_sentinel();
+        }
+        // После массового освобождения пул и горячая арена уже пусты
+        drain_node_pool();
+        hot_arena.release(node_allocator);
 
-        if (skip_list_heads != nullptr) {
-            delete[] skip_list_heads;
-            skip_list_heads = nullptr;
+        deallocate_level_tails();
+    }
+
+    void deallocate_level_tails() noexcept {
+        if (level_tails != nullptr) {
+            PointerAllocator pointer_allocator(node_allocator);
+            std::allocator_traits<PointerAllocator>::deallocate(pointer_allocator, level_tails, MAX_SKIP_LEVEL);
+            level_tails = nullptr;
         }
     }
 
@@ -179,62 +296,267 @@ private:
         }
     }
 
-    Node<T>* allocate_and_construct_node(const value_type& val, int level) {
-        Node<T>* new_node = node_allocator.allocate(1);
-        try {
-            std::allocator_traits<NodeAllocator>::construct(node_allocator, new_node, val, level);
-        } catch (...) {
-            node_allocator.deallocate(new_node, 1);
-            throw;
+    static ValueNode* as_node(BaseNode* node) noexcept {
+        return static_cast<ValueNode*>(node);
+    }
+
+    static const value_type& value_of(const BaseNode* node) noexcept {
+        return static_cast<const ValueNode*>(node)->get();
+    }
+
+    // Сравнения при поиске идут через KeyPolicy и читают только то, что ей нужно.
+    // P - probe политики: KeyPolicy::probe или, при прозрачном Compare, probe чужого типа ключа.
+    template <typename P>
+    bool node_less(const BaseNode* node, const P& probe) const {
+        const ValueNode* value_node = static_cast<const ValueNode*>(node);
+        return KeyPolicy::less(compare, value_node->key, value_node->get(), probe);
+    }
+
+    template <typename P>
+    bool node_equal(const BaseNode* node, const P& probe) const {
+        const ValueNode* value_node = static_cast<const ValueNode*>(node);
+        return KeyPolicy::equal(compare, value_node->key, value_node->get(), probe);
+    }
+
+    static Probe probe_of(const BaseNode* node) {
+        const ValueNode* value_node = static_cast<const ValueNode*>(node);
+        return KeyPolicy::node_probe(value_node->key, value_node->get());
+    }
+
+    // Узел node->forward(i) существует и меньше probe. С толстыми связями ответ
+    // дает копия ключа в самой связи, и следующий узел не читается.
+    template <typename P>
+    bool forward_less(const BaseNode* node, int i, const P& probe) const {
+        const BaseNode* next = node->forward(i);
+        if (next == sentinel_node) {
+            return false;
+        }
+        if constexpr (BaseNode::HAS_LINK_KEYS) {
+            return KeyPolicy::link_less(compare, node->link_key(i), probe);
+        } else {
+            return node_less(next, probe);
         }
-        return new_node;
     }
 
-    Node<T>* allocate_and_construct_node(value_type&& val, int level) {
-        Node<T>* new_node = node_allocator.allocate(1);
-        try {
-            std::allocator_traits<NodeAllocator>::construct(node_allocator, new_node, std::move(val), level);
-        } catch (...) {
-            node_allocator.deallocate(new_node, 1);
-            throw;
+    // Вставляет node после predecessor на уровне i.
+    static void link_after(BaseNode* predecessor, int i, BaseNode* node) {
+        node->forward(i) = predecessor->forward(i);
+        predecessor->forward(i) = node;
+        if constexpr (BaseNode::HAS_LINK_KEYS) {
+            node->link_key(i) = predecessor->link_key(i);
+            const ValueNode* value_node = static_cast<const ValueNode*>(node);
+            predecessor->link_key(i) = KeyPolicy::link_of(value_node->key, value_node->get());
         }
-        return new_node;
     }
 
-    Node<T>* allocate_and_construct_sentinel() {
-        Node<T>* new_node = node_allocator.allocate(1);
+    // Направляет связь уровня i узла from на node (вместе с копией ключа node).
+    static void point_forward(BaseNode* from, int i, BaseNode* node) {
+        from->forward(i) = node;
+        if constexpr (BaseNode::HAS_LINK_KEYS) {
+            const ValueNode* value_node = static_cast<const ValueNode*>(node);
+            from->link_key(i) = KeyPolicy::link_of(value_node->key, value_node->get());
+        }
+    }
+
+    // Убирает node, стоящий после predecessor на уровне i.
+    static void unlink_after(BaseNode* predecessor, int i, BaseNode* node) noexcept {
+        predecessor->forward(i) = node->forward(i);
+        if constexpr (BaseNode::HAS_LINK_KEYS) {
+            predecessor->link_key(i) = node->link_key(i);
+        }
+    }
+
+    template <typename NodeType>
+    bool uses_hot_arena(int level) const noexcept {
+        return level >= min_hot_level
+            && HotTowerArena::fits(Storage::template units<NodeType>(level) * sizeof(Storage));
+    }
+
+    Storage* allocate_storage(std::size_t units, bool hot) {
+        if (hot) {
+            return static_cast<Storage*>(hot_arena.allocate(units * sizeof(Storage), node_allocator));
+        }
+        return std::allocator_traits<NodeAllocator>::allocate(node_allocator, units);
+    }
+
+    void deallocate_storage(Storage* storage, std::size_t units, bool hot) noexcept {
+        if (hot) {
+            hot_arena.deallocate(storage, units * sizeof(Storage));
+        } else {
+            std::allocator_traits<NodeAllocator>::deallocate(node_allocator, storage, units);
+        }
+    }
+
+    void drain_node_pool() noexcept {
+        node_pool.drain([this](Storage* block, int level) {
+            deallocate_storage(block, Storage::template units<ValueNode>(level), uses_hot_arena<ValueNode>(level));
+        });
+        std::fill(std::begin(reserved_levels), std::end(reserved_levels), 0);
+        reserved_nodes = 0;
+    }
+
+    void swap_node_storage(Container& other) noexcept {
+        using std::swap;
+        node_pool.swap(other.node_pool);
+        swap(reserved_levels, other.reserved_levels);
+        swap(reserved_nodes, other.reserved_nodes);
+        swap(cached_nodes_limit, other.cached_nodes_limit);
+        swap(compact_region, other.compact_region);
+        swap(compact_region_units, other.compact_region_units);
+        swap(compact_region_nodes, other.compact_region_nodes);
+    }
+
+    bool in_compact_region(const Storage* block) const noexcept {
+        return compact_region != nullptr
+            && std::less_equal<const Storage*>()(compact_region, block)
+            && std::less<const Storage*>()(block, compact_region + compact_region_units);
+    }
+
+    void release_compact_region() noexcept {
+        if (compact_region != nullptr) {
+            std::allocator_traits<NodeAllocator>::deallocate(node_allocator, compact_region, compact_region_units);
+            compact_region = nullptr;
+            compact_region_units = 0;
+            compact_region_nodes = 0;
+        }
+    }
+
+    size_type cached_nodes() const noexcept {
+        return node_pool.size() - reserved_nodes;
+    }
+
+    // Возвращает аллокатору сохраненные узлы сверх лимита, начиная с высоких башен.
+    void trim_node_cache() noexcept {
+        for (int level = MAX_SKIP_LEVEL - 1; level >= 0 && cached_nodes() > cached_nodes_limit; --level) {
+            while (cached_nodes() > cached_nodes_limit && node_pool.count(level) > reserved_levels[level]) {
+                deallocate_storage(node_pool.pop(level), Storage::template units<ValueNode>(level),
+                                   uses_hot_arena<ValueNode>(level));
+            }
+        }
+    }
+
+    // Выделяет блок под башню и заголовок NodeType и конструирует заголовок после башни.
+    // Узлы со значением сначала берут блок своей высоты из пула.
+    template <typename NodeType, typename... Args>
+    NodeType* allocate_and_construct(int level, Args&&... args) {
+        const std::size_t units = Storage::template units<NodeType>(level);
+        const bool hot = uses_hot_arena<NodeType>(level);
+        Storage* storage = nullptr;
+        if constexpr (std::is_same_v<NodeType, ValueNode>) {
+            storage = node_pool.pop(level);
+        }
+        if (storage == nullptr) {
+            storage = allocate_storage(units, hot);
+        }
+        NodeType* new_node = reinterpret_cast<NodeType*>(
+            reinterpret_cast<unsigned char*>(storage) + BaseNode::template tower_bytes<NodeType>(level));
         try {
-            std::allocator_traits<NodeAllocator>::construct(node_allocator, new_node, true, MAX_SKIP_LEVEL);
+            std::allocator_traits<NodeAllocator>::construct(node_allocator, new_node, std::forward<Args>(args)...);
         } catch (...) {
-            node_allocator.deallocate(new_node, 1);
+            deallocate_storage(storage, units, hot);
             throw;
         }
         return new_node;
     }
 
-    void destroy_and_deallocate_node(Node<T>* node) {
-        if (node == nullptr) return;
+    // Узел со значением остается в пуле для следующей вставки, пока не достигнут лимит.
+    template <typename NodeType>
+    void destroy_and_deallocate(NodeType* node) noexcept {
+        const int level = node->tower_level();
+        unsigned char* block = reinterpret_cast<unsigned char*>(node) - BaseNode::template tower_bytes<NodeType>(level);
         std::allocator_traits<NodeAllocator>::destroy(node_allocator, node);
-        node_allocator.deallocate(node, 1);
+        if constexpr (std::is_same_v<NodeType, ValueNode>) {
+            if (in_compact_region(reinterpret_cast<Storage*>(block))) {
+                if (--compact_region_nodes == 0) {
+                    release_compact_region();
+                }
+                return;
+            }
+            if (cached_nodes() < cached_nodes_limit) {
+                node_pool.push(level, reinterpret_cast<Storage*>(block));
+                return;
+            }
+        }
+        deallocate_storage(reinterpret_cast<Storage*>(block), Storage::template units<NodeType>(level),
+                           uses_hot_arena<NodeType>(level));
+    }
+
+    template <typename V>
+    ValueNode* allocate_and_construct_node(V&& val, int level) {
+        if constexpr (ValueNode::VALUE_OUT_OF_LINE) {
+            ValueAllocator value_allocator(node_allocator);
+            T* payload = std::allocator_traits<ValueAllocator>::allocate(value_allocator, 1);
+            try {
+                std::allocator_traits<ValueAllocator>::construct(value_allocator, payload, std::forward<V>(val));
+            } catch (...) {
+                std::allocator_traits<ValueAllocator>::deallocate(value_allocator, payload, 1);
+                throw;
+            }
+            try {
+                return allocate_and_construct<ValueNode>(level, payload, level);
+            } catch (...) {
+                destroy_and_deallocate_payload(payload);
+                throw;
+            }
+        } else if constexpr (std::uses_allocator_v<T, Allocator>
+                             && !std::allocator_traits<Allocator>::is_always_equal::value) {
+            // T с аллокатором (std::pmr::string и т.п.) получает аллокатор контейнера,
+            // как в стандартных контейнерах; перемещение в узел его сохраняет.
+            // Аллокаторы без состояния (std::allocator) передавать незачем
+            return allocate_and_construct<ValueNode>(
+                level, std::make_obj_using_allocator<T>(get_allocator(), std::forward<V>(val)), level);
+        } else {
+            return allocate_and_construct<ValueNode>(level, std::forward<V>(val), level);
+        }
+    }
+
+    void destroy_and_deallocate_payload(T* payload) noexcept {
+        ValueAllocator value_allocator(node_allocator);
+        std::allocator_traits<ValueAllocator>::destroy(value_allocator, payload);
+        std::allocator_traits<ValueAllocator>::deallocate(value_allocator, payload, 1);
+    }
+
+    BaseNode* allocate_and_construct_sentinel() {
+        return allocate_and_construct<BaseNode>(MAX_SKIP_LEVEL - 1);
+    }
+
+    void destroy_and_deallocate_node(BaseNode* node) noexcept {
+        if (node == nullptr) return;
+        if constexpr (ValueNode::VALUE_OUT_OF_LINE) {
+            T* payload = as_node(node)->value;
+            destroy_and_deallocate(as_node(node));
+            destroy_and_deallocate_payload(payload);
+        } else {
+            destroy_and_deallocate(as_node(node));
+        }
     }
 
-    void insert_dll_node_before(Node<T>* new_node, Node<T>* position_node) {
-        Node<T>* prev_node = position_node->prev;
+    void destroy_and_deallocate_sentinel() noexcept {
+        destroy_and_deallocate(sentinel_node);
+        sentinel_node = nullptr;
+    }
 
-        new_node->next = position_node;
-        new_node->prev = prev_node;
-        prev_node->next = new_node;
-        position_node->prev = new_node;
+    // Прямые связи DLL - это уровень 0 Skip List, здесь поддерживаются только prev.
+    void insert_dll_node_before(BaseNode* new_node, BaseNode* position_node) {
+        if constexpr (Bidirectional) {
+            new_node->prev = position_node->prev;
+            position_node->prev = new_node;
+        }
 
         num_elements++;
     }
 
-    void remove_dll_node(Node<T>* node_to_remove) {
-        node_to_remove->prev->next = node_to_remove->next;
-        node_to_remove->next->prev = node_to_remove->prev;
+    void remove_dll_node(BaseNode* node_to_remove) {
+        if constexpr (Bidirectional) {
+            node_to_remove->forward(0)->prev = node_to_remove->prev;
+        }
         num_elements--;
     }
 
+    BaseNode* last_node() const noexcept {
+        return level_tails[0];
+    }
+
     int get_random_level() const {
         int level = 0;
         while (dist(rng) < 0.5 && level < MAX_SKIP_LEVEL - 1) {
@@ -243,56 +565,318 @@ private:
         return level;
     }
 
-    void remove_from_skip_list(Node<T>* node_to_remove) {
-        Node<T>* update[MAX_SKIP_LEVEL];
-        Node<T>* current = sentinel_node;
+    // Высота нового узла. Блоки reserve() получили высоты от того же генератора,
+    // поэтому выбор среди них случайно без возвращения распределение не меняет, и
+    // вставка гарантированно находит блок своей высоты. Высоты сохраненных удаленных
+    // узлов зависят от того, какие узлы удаляли, так что их не выбираем: высота
+    // берется от генератора, а блок из пула - только если такой высоты он там есть.
+    int next_node_level() {
+        if (reserved_nodes == 0) {
+            return get_random_level();
+        }
+        std::uniform_int_distribution<size_type> pick(0, reserved_nodes - 1);
+        size_type index = pick(rng);
+        int level = 0;
+        while (index >= reserved_levels[level]) {
+            index -= reserved_levels[level];
+            level++;
+        }
+        reserved_levels[level]--;
+        reserved_nodes--;
+        return level;
+    }
+
+    void remove_from_skip_list(BaseNode* node_to_remove) {
+        BaseNode* update[MAX_SKIP_LEVEL];
+        BaseNode* current = sentinel_node;
+        const Probe probe = probe_of(node_to_remove);
 
         for (int i = current_max_level; i >= 0; --i) {
-            while (current->forward[i] != sentinel_node && current->forward[i]->value < node_to_remove->value) {
-                current = current->forward[i];
+            while (forward_less(current, i, probe)) {
+                current = current->forward(i);
+            }
+            // Среди дубликатов доходим до самого удаляемого узла, а не до первого равного
+            if (i <= node_to_remove->level) {
+                while (current->forward(i) != node_to_remove && current->forward(i) != sentinel_node) {
+                    current = current->forward(i);
+                }
             }
             update[i] = current;
         }
 
-        current = update[0]->forward[0];
+        if (current->forward(0) == node_to_remove) {
+            unlink_from_skip_list(node_to_remove, update);
+        }
+    }
 
-        if (current != sentinel_node && current == node_to_remove) {
-            for (int i = 0; i <= current->level; ++i) {
-                if (update[i]->forward[i] == node_to_remove) {
-                    update[i]->forward[i] = node_to_remove->forward[i];
-                }
+    // update[0..level] - предшественники node_to_remove на каждом его уровне.
+    void unlink_from_skip_list(BaseNode* node_to_remove, BaseNode* const* update) {
+        for (int i = 0; i <= node_to_remove->level; ++i) {
+            if (update[i]->forward(i) == node_to_remove) {
+                unlink_after(update[i], i, node_to_remove);
             }
-
-            while (current_max_level > 0 && sentinel_node->forward[current_max_level] == sentinel_node) {
-                current_max_level--;
+            if (level_tails[i] == node_to_remove) {
+                level_tails[i] = update[i];
             }
         }
+
+        while (current_max_level > 0 && sentinel_node->forward(current_max_level) == sentinel_node) {
+            current_max_level--;
+        }
+    }
+
+    // Узел node->forward(i) существует и не больше probe.
+    template <typename P>
+    bool forward_not_greater(const BaseNode* node, int i, const P& probe) const {
+        return forward_less(node, i, probe)
+            || (node->forward(i) != sentinel_node && node_equal(node->forward(i), probe));
     }
 
-    Node<T>* find_node_in_skip_list(const value_type& value) const {
-        Node<T>* current = sentinel_node;
+    // Первый узел, не меньший probe (sentinel, если такого нет).
+    template <typename P>
+    BaseNode* lower_bound_node(const P& probe) const {
+        BaseNode* current = sentinel_node;
+        for (int i = current_max_level; i >= 0; --i) {
+            while (forward_less(current, i, probe)) {
+                current = current->forward(i);
+            }
+        }
+        return current->forward(0);
+    }
 
+    // Первый узел, больший probe (sentinel, если такого нет).
+    template <typename P>
+    BaseNode* upper_bound_node(const P& probe) const {
+        BaseNode* current = sentinel_node;
         for (int i = current_max_level; i >= 0; --i) {
-            while (current->forward[i] != sentinel_node && current->forward[i]->value < value) {
-                current = current->forward[i];
+            while (forward_not_greater(current, i, probe)) {
+                current = current->forward(i);
             }
         }
-        current = current->forward[0];
+        return current->forward(0);
+    }
+
+    template <typename K>
+    BaseNode* find_node_in_skip_list(const K& key) const {
+        const auto probe = KeyPolicy::make_probe(key);
+        BaseNode* current = lower_bound_node(probe);
 
-        if (current != sentinel_node && current->value == value) {
+        if (current != sentinel_node && node_equal(current, probe)) {
             return current;
         }
         return nullptr;
     }
 
+    iterator insert_node(BaseNode* new_node) {
+        const Probe probe = probe_of(new_node);
+        BaseNode* update[MAX_SKIP_LEVEL] = {}; // Инициализация только глушит -Wmaybe-uninitialized
+        BaseNode* current = sentinel_node;
+
+        for (int i = current_max_level; i >= 0; --i) {
+            while (forward_less(current, i, probe)) {
+                current = current->forward(i);
+            }
+            update[i] = current;
+        }
+        return link_new_node(new_node, update);
+    }
+
+    // Вставка с подсказкой: узел встает туда же, куда его поставил бы insert_node
+    // (после всех меньших), но поиск идет от hint, а не от вершины списка.
+    //   - hint верна (prev(hint) < value <= hint): предшественник на уровне 0 - prev(hint);
+    //   - позиция правее hint: подъем по башням от hint и спуск, O(log d),
+    //     где d - расстояние от hint до позиции; спуск запоминает путь по уровням;
+    //   - позиция левее: шаги назад по prev до узла меньше probe (find_left_anchor),
+    //     затем тот же поиск вперед от него; O(log d) сравнений, но шагов назад
+    //     до 2 * (current_max_level + 1), дальше - обычный поиск сверху.
+    // Предшественники на уровнях выше найденного пути ищет upper_predecessors.
+    // Без prev (Bidirectional == false) подсказка не используется.
+    iterator insert_node_near(BaseNode* hint, BaseNode* new_node) {
+        if constexpr (!Bidirectional) {
+            return insert_node(new_node);
+        } else {
+            const Probe probe = probe_of(new_node);
+            BaseNode* update[MAX_SKIP_LEVEL] = {};
+            int known_level;
+            if (hint != sentinel_node && node_less(hint, probe)) {
+                known_level = finger_search_forward(hint, probe, update);
+            } else if (hint->prev == sentinel_node || node_less(hint->prev, probe)) {
+                // prev(hint)->forward(i) на любом его уровне - не левее hint, то есть не меньше probe
+                known_level = hint->prev->tower_level();
+                std::fill(update, update + known_level + 1, hint->prev);
+            } else {
+                BaseNode* anchor = find_left_anchor(hint->prev, probe);
+                if (anchor == sentinel_node) {
+                    return insert_node(new_node);
+                }
+                known_level = finger_search_forward(anchor, probe, update);
+            }
+
+            const int top = std::min<int>(new_node->level, current_max_level);
+            if (top > known_level) {
+                upper_predecessors(update, known_level + 1, top, probe);
+            }
+            return link_new_node(new_node, update);
+        }
+    }
+
+    // Узел меньше probe левее start (start не меньше probe) или sentinel. У башен
+    // назад есть только prev уровня 0, поэтому шаги идут по нему, а сравнивается
+    // только узел выше всех пройденных до него: башня высоты h встречается примерно через
+    // 2^h шагов, и до узла левее позиции на расстоянии d выходит O(log d) сравнений.
+    // Шаги ограничены так же, как в upper_predecessors: дальний поиск дешевле сверху.
+    BaseNode* find_left_anchor(BaseNode* start, const Probe& probe) const {
+        int steps_left = 2 * (current_max_level + 1);
+        int tallest = -1;
+        BaseNode* current = start;
+        while (steps_left-- > 0) {
+            current = current->prev;
+            CONTAINER_PREV_STEP();
+            if (current == sentinel_node) {
+                break;
+            }
+            if (current->level > tallest) {
+                tallest = current->level;
+                if (node_less(current, probe)) {
+                    return current;
+                }
+            }
+        }
+        return sentinel_node;
+    }
+
+    // Заполняет update[0..k] последними узлами, меньшими probe, на каждом уровне
+    // и возвращает k (start < probe). Подъем идет, пока следующая связь уровнем
+    // выше еще меньше probe; узел, на котором он остановился, - предшественник
+    // на всех своих уровнях выше текущего, ниже путь записывает спуск.
+    int finger_search_forward(BaseNode* start, const Probe& probe, BaseNode** update) const {
+        BaseNode* current = start;
+        int i = 0;
+        while (true) {
+            while (i < current->level && forward_less(current, i + 1, probe)) {
+                ++i;
+            }
+            if (!forward_less(current, i, probe)) {
+                break;
+            }
+            current = current->forward(i);
+        }
+        const int known_level = current->level;
+        std::fill(update + i, update + known_level + 1, current);
+        for (; i >= 0; --i) {
+            while (forward_less(current, i, probe)) {
+                current = current->forward(i);
+            }
+            update[i] = current;
+        }
+        return known_level;
+    }
+
+    // Предшественники на уровнях from..top, когда update[from - 1] уже известен.
+    // Ближайшая башня высоты i левее update[i - 1] находится шагами назад по prev
+    // (около 2^i шагов), поэтому шаги назад ограничены current_max_level: оставшиеся
+    // уровни дает спуск от sentinel за O(log n). В среднем выходит O(log log n)
+    // на вставку, в худшем случае - O(log n), даже в разреженной области списка.
+    void upper_predecessors(BaseNode** update, int from, int top, const Probe& probe) const {
+        int steps_left = current_max_level;
+        BaseNode* current = update[from - 1];
+        int i = from;
+        for (; i <= top; ++i) {
+            while (current->level < i && steps_left > 0) {
+                current = current->prev;
+                CONTAINER_PREV_STEP();
+                --steps_left;
+            }
+            if (current->level < i) {
+                break;
+            }
+            update[i] = current;
+        }
+        if (i > top) {
+            return;
+        }
+
+        current = sentinel_node;
+        for (int level = current_max_level; level >= i; --level) {
+            while (forward_less(current, level, probe)) {
+                current = current->forward(level);
+            }
+            if (level <= top) {
+                update[level] = current;
+            }
+        }
+    }
+
+    // update[0..min(level, current_max_level)] - предшественники new_node на каждом уровне.
+    iterator link_new_node(BaseNode* new_node, BaseNode** update) {
+        BaseNode* next_dll_node = update[0]->forward(0);
+        insert_dll_node_before(new_node, next_dll_node);
+
+        if (new_node->level > current_max_level) {
+            for (int i = current_max_level + 1; i <= new_node->level; ++i) {
+                update[i] = sentinel_node;
+            }
+            current_max_level = new_node->level;
+        }
+
+        for (int i = 0; i <= new_node->level; ++i) {
+            link_after(update[i], i, new_node);
+            if (new_node->forward(i) == sentinel_node) {
+                level_tails[i] = new_node;
+            }
+        }
+
+        return iterator(new_node);
+    }
+
+    // Ключ node не больше probe.
+    bool node_not_greater(const BaseNode* node, const Probe& probe) const {
+        return node_less(node, probe) || node_equal(node, probe);
+    }
+
+    void push_back_node(BaseNode* new_node) {
+        if (num_elements == 0 || node_not_greater(last_node(), probe_of(new_node))) {
+            append_node(new_node);
+        } else {
+            insert_node(new_node);
+        }
+    }
+
+    void push_front_node(BaseNode* new_node) {
+        if (num_elements == 0 || !node_less(sentinel_node->forward(0), probe_of(new_node))) {
+            prepend_node(new_node);
+        } else {
+            insert_node(new_node);
+        }
+    }
+
+    // Вставка в конец для значения >= back(): предшественники на всех уровнях - хвосты.
+    iterator append_node(BaseNode* new_node) {
+        BaseNode* update[MAX_SKIP_LEVEL];
+        std::copy(level_tails, level_tails + MAX_SKIP_LEVEL, update);
+        return link_new_node(new_node, update);
+    }
+
+    // Вставка в начало для значения <= front(): предшественник на всех уровнях - sentinel.
+    iterator prepend_node(BaseNode* new_node) {
+        BaseNode* update[MAX_SKIP_LEVEL];
+        std::fill(std::begin(update), std::end(update), sentinel_node);
+        return link_new_node(new_node, update);
+    }
+
 
 public:
     explicit Container(const Allocator& alloc = Allocator()) :
+        Container(Compare(), alloc) {}
+
+    explicit Container(const Compare& comp, const Allocator& alloc = Allocator()) :
         node_allocator(alloc),
+        compare(comp),
         sentinel_node(nullptr),
         num_elements(0),
-        skip_list_heads(nullptr),
-        current_max_level(0)
+        level_tails(nullptr),
+        current_max_level(0),
+        min_hot_level(MAX_SKIP_LEVEL)
     {
         initialize_container();
     }
@@ -327,6 +911,19 @@ public:
         }
     }
 
+    template <typename InputIt,
+              typename = std::enable_if_t<
+                  std::is_base_of<std::input_iterator_tag,
+                                  typename std::iterator_traits<InputIt>::iterator_category>::value
+              >>
+    Container(InputIt first, InputIt last, const Compare& comp, const Allocator& alloc = Allocator()) :
+        Container(comp, alloc)
+    {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
     Container(std::initializer_list<value_type> init, const Allocator& alloc = Allocator()) :
         Container(alloc)
     {
@@ -335,12 +932,23 @@ public:
         }
     }
 
+    Container(std::initializer_list<value_type> init, const Compare& comp, const Allocator& alloc = Allocator()) :
+        Container(comp, alloc)
+    {
+        for (const auto& val : init) {
+            push_back(val);
+        }
+    }
+
     Container(const Container& other) :
         node_allocator(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator())),
+        compare(other.compare),
         sentinel_node(nullptr),
         num_elements(0),
-        skip_list_heads(nullptr),
-        current_max_level(0)
+        level_tails(nullptr),
+        current_max_level(0),
+        min_hot_level(other.min_hot_level),
+        cached_nodes_limit(other.cached_nodes_limit)
     {
         initialize_container();
         copy_container_nodes_from(other);
@@ -348,10 +956,13 @@ public:
 
     Container(const Container& other, const Allocator& alloc) :
         node_allocator(alloc),
+        compare(other.compare),
         sentinel_node(nullptr),
         num_elements(0),
-        skip_list_heads(nullptr),
-        current_max_level(0)
+        level_tails(nullptr),
+        current_max_level(0),
+        min_hot_level(other.min_hot_level),
+        cached_nodes_limit(other.cached_nodes_limit)
     {
         initialize_container();
         copy_container_nodes_from(other);
@@ -359,36 +970,44 @@ public:
 
     Container(Container&& other) noexcept :
         node_allocator(std::move(other.node_allocator)),
+        compare(other.compare),
         sentinel_node(other.sentinel_node),
         num_elements(other.num_elements),
-        skip_list_heads(other.skip_list_heads),
+        level_tails(other.level_tails),
         current_max_level(other.current_max_level),
+        hot_arena(std::move(other.hot_arena)),
+        min_hot_level(other.min_hot_level),
         rng(std::move(other.rng)),
         dist(std::move(other.dist))
     {
+        swap_node_storage(other);
         other.sentinel_node = nullptr;
         other.num_elements = 0;
-        other.skip_list_heads = nullptr;
+        other.level_tails = nullptr;
         other.current_max_level = 0;
     }
 
     Container(Container&& other, const Allocator& alloc) :
         node_allocator(alloc),
+        compare(other.compare),
         sentinel_node(nullptr),
         num_elements(0),
-        skip_list_heads(nullptr),
-        current_max_level(0)
+        level_tails(nullptr),
+        current_max_level(0),
+        min_hot_level(other.min_hot_level)
     {
         if (node_allocator == other.node_allocator) {
             sentinel_node = other.sentinel_node;
             num_elements = other.num_elements;
-            skip_list_heads = other.skip_list_heads;
+            level_tails = other.level_tails;
             current_max_level = other.current_max_level;
+            hot_arena.swap(other.hot_arena);
+            swap_node_storage(other);
             rng = std::move(other.rng);
             dist = std::move(other.dist);
 
             other.sentinel_node = nullptr;
-            other.skip_list_heads = nullptr;
+            other.level_tails = nullptr;
             other.num_elements = 0;
             other.current_max_level = 0;
         } else {
@@ -404,7 +1023,9 @@ public:
 
     Container& operator=(const Container& other) {
         if (this != &other) {
-            if (std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value) {
+            compare = other.compare;
+            // if constexpr: аллокаторы без распространения (polymorphic_allocator) не присваиваются
+            if constexpr (std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value) {
                 if (node_allocator != other.node_allocator) {
                     destroy_container_nodes();
                     node_allocator = other.node_allocator;
@@ -423,33 +1044,41 @@ public:
     Container& operator=(Container&& other) noexcept {
         if (this != &other) {
             destroy_container_nodes();
+            compare = other.compare;
 
-            if (std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value) {
+            if constexpr (std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value) {
                 node_allocator = std::move(other.node_allocator);
                 sentinel_node = other.sentinel_node;
                 num_elements = other.num_elements;
-                skip_list_heads = other.skip_list_heads;
+                level_tails = other.level_tails;
                 current_max_level = other.current_max_level;
+                hot_arena.swap(other.hot_arena);
+                swap_node_storage(other);
+                min_hot_level = other.min_hot_level;
                 rng = std::move(other.rng);
                 dist = std::move(other.dist);
 
                 other.sentinel_node = nullptr;
                 other.num_elements = 0;
-                other.skip_list_heads = nullptr;
+                other.level_tails = nullptr;
                 other.current_max_level = 0;
             } else if (node_allocator == other.node_allocator) {
                 sentinel_node = other.sentinel_node;
                 num_elements = other.num_elements;
-                skip_list_heads = other.skip_list_heads;
+                level_tails = other.level_tails;
                 current_max_level = other.current_max_level;
+                hot_arena.swap(other.hot_arena);
+                swap_node_storage(other);
+                min_hot_level = other.min_hot_level;
                 rng = std::move(other.rng);
                 dist = std::move(other.dist);
 
                 other.sentinel_node = nullptr;
                 other.num_elements = 0;
-                other.skip_list_heads = nullptr;
+                other.level_tails = nullptr;
                 other.current_max_level = 0;
             } else {
+                initialize_container();
                 copy_container_nodes_from(other);
                 other.clear();
             }
@@ -469,44 +1098,48 @@ public:
         return node_allocator;
     }
 
+    key_compare key_comp() const {
+        return compare;
+    }
+
     reference front() {
         if (empty()) {
             throw std::out_of_range("front() called on empty container.");
         }
-        return sentinel_node->next->value;
+        return as_node(sentinel_node->forward(0))->get();
     }
 
     const_reference front() const {
         if (empty()) {
             throw std::out_of_range("front() called on empty container.");
         }
-        return sentinel_node->next->value;
+        return value_of(sentinel_node->forward(0));
     }
 
     reference back() {
         if (empty()) {
             throw std::out_of_range("back() called on empty container.");
         }
-        return sentinel_node->prev->value;
+        return as_node(last_node())->get();
     }
 
     const_reference back() const {
         if (empty()) {
             throw std::out_of_range("back() called on empty container.");
         }
-        return sentinel_node->prev->value;
+        return value_of(last_node());
     }
 
     iterator begin() noexcept {
-        return iterator(sentinel_node->next);
+        return iterator(sentinel_node->forward(0));
     }
 
     const_iterator begin() const noexcept {
-        return const_iterator(sentinel_node->next);
+        return const_iterator(sentinel_node->forward(0));
     }
 
     const_iterator cbegin() const noexcept {
-        return const_iterator(sentinel_node->next);
+        return const_iterator(sentinel_node->forward(0));
     }
 
     iterator end() noexcept {
@@ -530,89 +1163,214 @@ public:
     }
 
     size_type max_size() const noexcept {
-        return std::allocator_traits<NodeAllocator>::max_size(node_allocator);
+        return std::allocator_traits<NodeAllocator>::max_size(node_allocator) / Storage::template units<ValueNode>(0);
     }
 
-    void clear() noexcept {
-        destroy_container_nodes();
-        initialize_container();
+    // Число элементов, которое контейнер вместит без обращений к аллокатору за узлами.
+    size_type capacity() const noexcept {
+        return num_elements + reserved_nodes;
     }
 
-    iterator insert([[maybe_unused]] const_iterator pos, const value_type& value) {
-        int node_level = get_random_level();
-        Node<T>* new_node = allocate_and_construct_node(value, node_level);
+    // Заранее выделяет блоки под узлы, чтобы следующие n - size() вставок брали
+    // их из пула. Значения SplitKeyContainer по-прежнему выделяются при вставке.
+    void reserve(size_type n) {
+        if (n > max_size()) {
+            throw std::length_error("reserve() argument exceeds max_size().");
+        }
+        while (capacity() < n) {
+            const int level = get_random_level();
+            Storage* block = allocate_storage(Storage::template units<ValueNode>(level), uses_hot_arena<ValueNode>(level));
+            node_pool.push(level, block);
+            reserved_levels[level]++;
+            reserved_nodes++;
+        }
+    }
 
-        Node<T>* update[MAX_SKIP_LEVEL];
-        Node<T>* current = sentinel_node;
+    // Возвращает аллокатору все свободные блоки пула, включая сохраненные узлы.
+    void shrink_to_fit() noexcept {
+        drain_node_pool();
+    }
 
-        for (int i = current_max_level; i >= 0; --i) {
-            while (current->forward[i] != sentinel_node && current->forward[i]->value < value) {
-                current = current->forward[i];
-            }
-            update[i] = current;
+    // Перекладывает все узлы в один непрерывный блок памяти: сначала башни
+    // верхних уровней, ниже - нулевого, внутри уровня - в порядке ключей. После
+    // долгой серии вставок и удалений узлы разбросаны по куче, а так поиск снова
+    // идет по плотному верху списка, а обход - почти последовательно.
+    // Все итераторы, указатели и ссылки на элементы становятся недействительными.
+    // Если исключение (перемещение T или нехватка памяти), контейнер не меняется.
+    void defragment() {
+        if (empty()) {
+            return;
         }
 
-        Node<T>* next_dll_node = current->next;
-        insert_dll_node_before(new_node, next_dll_node);
+        size_type offsets[MAX_SKIP_LEVEL] = {};
+        for (BaseNode* node = sentinel_node->forward(0); node != sentinel_node; node = node->forward(0)) {
+            offsets[node->level] += Storage::template units<ValueNode>(node->level);
+        }
+        size_type region_units = 0;
+        for (int level = MAX_SKIP_LEVEL - 1; level >= 0; --level) {
+            const size_type level_units = offsets[level];
+            offsets[level] = region_units;
+            region_units += level_units;
+        }
 
-        if (new_node->level > current_max_level) {
-            for (int i = current_max_level + 1; i <= new_node->level; ++i) {
-                update[i] = sentinel_node;
+        Storage* region = std::allocator_traits<NodeAllocator>::allocate(node_allocator, region_units);
+        PointerAllocator pointer_allocator(node_allocator);
+        BaseNode** moved = nullptr;
+        try {
+            moved = std::allocator_traits<PointerAllocator>::allocate(pointer_allocator, num_elements);
+        } catch (...) {
+            std::allocator_traits<NodeAllocator>::deallocate(node_allocator, region, region_units);
+            throw;
+        }
+
+        // Новые узлы строятся рядом со старыми, старые пока не трогаются
+        size_type constructed = 0;
+        try {
+            for (BaseNode* node = sentinel_node->forward(0); node != sentinel_node; node = node->forward(0)) {
+                const int level = node->level;
+                ValueNode* new_node = reinterpret_cast<ValueNode*>(
+                    reinterpret_cast<unsigned char*>(region + offsets[level])
+                    + BaseNode::template tower_bytes<ValueNode>(level));
+                offsets[level] += Storage::template units<ValueNode>(level);
+                if constexpr (ValueNode::VALUE_OUT_OF_LINE) {
+                    // Значение остается на месте, переезжает только узел
+                    std::allocator_traits<NodeAllocator>::construct(node_allocator, new_node, as_node(node)->value, level);
+                } else {
+                    std::allocator_traits<NodeAllocator>::construct(
+                        node_allocator, new_node, std::move_if_noexcept(as_node(node)->value), level);
+                }
+                moved[constructed++] = new_node;
             }
-            current_max_level = new_node->level;
+        } catch (...) {
+            for (size_type k = 0; k < constructed; ++k) {
+                std::allocator_traits<NodeAllocator>::destroy(node_allocator, as_node(moved[k]));
+            }
+            std::allocator_traits<PointerAllocator>::deallocate(pointer_allocator, moved, num_elements);
+            std::allocator_traits<NodeAllocator>::deallocate(node_allocator, region, region_units);
+            throw;
         }
 
-        for (int i = 0; i <= new_node->level; ++i) {
-            new_node->forward[i] = update[i]->forward[i];
-            update[i]->forward[i] = new_node;
+        BaseNode* old_first = sentinel_node->forward(0);
+        BaseNode* last_at_level[MAX_SKIP_LEVEL];
+        std::fill(std::begin(last_at_level), std::end(last_at_level), sentinel_node);
+        for (size_type k = 0; k < num_elements; ++k) {
+            BaseNode* node = moved[k];
+            for (int i = 0; i <= node->level; ++i) {
+                point_forward(last_at_level[i], i, node);
+                last_at_level[i] = node;
+            }
+            if constexpr (Bidirectional) {
+                node->prev = k == 0 ? sentinel_node : moved[k - 1];
+            }
+        }
+        for (int i = 0; i < MAX_SKIP_LEVEL; ++i) {
+            last_at_level[i]->forward(i) = sentinel_node;
+            level_tails[i] = last_at_level[i];
+        }
+        if constexpr (Bidirectional) {
+            sentinel_node->prev = moved[num_elements - 1];
         }
+        std::allocator_traits<PointerAllocator>::deallocate(pointer_allocator, moved, num_elements);
 
-        return iterator(new_node);
+        // Старые узлы (и прежний регион, если узлы лежали в нем) освобождаются как обычно
+        for (BaseNode* node = old_first; node != sentinel_node;) {
+            BaseNode* next_node = node->forward(0);
+            destroy_and_deallocate(as_node(node));
+            node = next_node;
+        }
+        compact_region = region;
+        compact_region_units = region_units;
+        compact_region_nodes = num_elements;
     }
 
-    iterator insert([[maybe_unused]] const_iterator pos, value_type&& value) {
-        int node_level = get_random_level();
-        Node<T>* new_node = allocate_and_construct_node(std::move(value), node_level);
+    size_type node_cache_limit() const noexcept {
+        return cached_nodes_limit;
+    }
 
-        Node<T>* update[MAX_SKIP_LEVEL];
-        Node<T>* current = sentinel_node;
+    // До limit удаленных узлов сохраняются в пуле по высотам башен и переиспользуются
+    // следующими вставками той же высоты, минуя аллокатор. 0 (по умолчанию) - выключено.
+    void set_node_cache_limit(size_type limit) noexcept {
+        cached_nodes_limit = limit;
+        trim_node_cache();
+    }
 
-        for (int i = current_max_level; i >= 0; --i) {
-            while (current->forward[i] != sentinel_node && current->forward[i]->value < new_node->value) {
-                current = current->forward[i];
-            }
-            update[i] = current;
-        }
+    int hot_tower_level() const noexcept {
+        return min_hot_level;
+    }
 
-        Node<T>* next_dll_node = current->next;
-        insert_dll_node_before(new_node, next_dll_node);
+    // Узлы уровня >= level (и sentinel) будут выделяться из HotTowerArena -
+    // плотного региона, выровненного по кэш-линиям. MAX_SKIP_LEVEL выключает арену.
+    // Экспериментально: эффект на find небольшой и зависит от прогона (медианы
+    // bench_hot_towers на 200k: порог 4 быстрее примерно на 8%, 482-507 против 526-550 нс).
+    // Менять порог можно только у пустого контейнера: sentinel переезжает сразу.
+    void set_hot_tower_level(int level) {
+        if (level < 1 || level > MAX_SKIP_LEVEL) {
+            throw std::invalid_argument("Hot tower level must be in [1, MAX_SKIP_LEVEL].");
+        }
+        if (!empty()) {
+            throw std::logic_error("set_hot_tower_level() requires an empty container.");
+        }
+        // Размер блоков в пуле зависит от порога: они возвращаются аллокатору
+        drain_node_pool();
+        if (sentinel_node == nullptr) {
+            min_hot_level = level;
+            return;
+        }
 
-        if (new_node->level > current_max_level) {
-            for (int i = current_max_level + 1; i <= new_node->level; ++i) {
-                update[i] = sentinel_node;
-            }
-            current_max_level = new_node->level;
+        const int old_level = min_hot_level;
+        BaseNode* old_sentinel = sentinel_node;
+        min_hot_level = level;
+        try {
+            sentinel_node = allocate_and_construct_sentinel();
+        } catch (...) {
+            min_hot_level = old_level;
+            throw;
         }
 
-        for (int i = 0; i <= new_node->level; ++i) {
-            new_node->forward[i] = update[i]->forward[i];
-            update[i]->forward[i] = new_node;
+        // Старый sentinel возвращается туда, откуда был выделен
+        min_hot_level = old_level;
+        destroy_and_deallocate(old_sentinel);
+        min_hot_level = level;
+        reset_skip_list();
+    }
+
+    // Sentinel, хвосты уровней и генератор уровней переживают clear(): после первого
+    // заполнения очистка не обращается к аллокатору (кроме освобождения самих узлов).
+    void clear() noexcept {
+        if (sentinel_node != nullptr && !release_nodes_in_bulk()) {
+            destroy_element_nodes();
         }
+        allocate_sentinel_and_tails();
+        reset_skip_list();
+    }
 
-        return iterator(new_node);
+    // pos - подсказка: вставка рядом с ней стоит O(log d) сравнений, см. insert_node_near.
+    iterator insert(const_iterator pos, const value_type& value) {
+        return insert_node_near(const_cast<BaseNode*>(pos.current_node),
+                                allocate_and_construct_node(value, next_node_level()));
     }
 
-    iterator insert([[maybe_unused]] const_iterator pos, size_type count, const value_type& value) {
+    iterator insert(const_iterator pos, value_type&& value) {
+        return insert_node_near(const_cast<BaseNode*>(pos.current_node),
+                                allocate_and_construct_node(std::move(value), next_node_level()));
+    }
+
+    // Каждая следующая вставка получает в подсказку предыдущий вставленный узел:
+    // копии одного значения встают друг перед другом за O(1).
+    iterator insert(const_iterator pos, size_type count, const value_type& value) {
         if (count == 0) {
-            return iterator(const_cast<Node<T>*>(pos.current_node));
+            return iterator(const_cast<BaseNode*>(pos.current_node));
         }
 
         iterator first_inserted_it = end();
         bool first_set = false;
+        const_iterator hint = pos;
 
         for (size_type i = 0; i < count; ++i) {
-            iterator current_it = insert(end(), value);
-            if (!first_set || (current_it != end() && (*current_it < *first_inserted_it))) {
+            iterator current_it = insert(hint, value);
+            hint = current_it;
+            if (!first_set || (current_it != end() &&
+                               node_less(current_it.current_node, probe_of(first_inserted_it.current_node)))) {
                 first_inserted_it = current_it;
                 first_set = true;
             }
@@ -626,13 +1384,18 @@ public:
                                   typename std::iterator_traits<InputIt>::iterator_category>::value
                   && !std::is_same_v<std::remove_reference_t<InputIt>, size_type>
               >>
-    iterator insert([[maybe_unused]] const_iterator pos, InputIt first, InputIt last) {
+    // Подсказка для каждого элемента - предыдущий вставленный: отсортированный или
+    // почти отсортированный диапазон вставляется за O(log d) на элемент.
+    iterator insert(const_iterator pos, InputIt first, InputIt last) {
         iterator first_inserted_it = end();
         bool first_set = false;
+        const_iterator hint = pos;
 
         for (auto it = first; it != last; ++it) {
-            iterator current_it = insert(end(), *it);
-            if (!first_set || (current_it != end() && (*current_it < *first_inserted_it))) {
+            iterator current_it = insert(hint, *it);
+            hint = current_it;
+            if (!first_set || (current_it != end() &&
+                               node_less(current_it.current_node, probe_of(first_inserted_it.current_node)))) {
                 first_inserted_it = current_it;
                 first_set = true;
             }
@@ -640,8 +1403,8 @@ public:
         return first_inserted_it;
     }
 
-    iterator insert([[maybe_unused]] const_iterator pos, std::initializer_list<value_type> ilist) {
-        return insert(end(), ilist.begin(), ilist.end());
+    iterator insert(const_iterator pos, std::initializer_list<value_type> ilist) {
+        return insert(pos, ilist.begin(), ilist.end());
     }
 
     iterator erase(const_iterator pos) {
@@ -649,8 +1412,8 @@ public:
             throw std::invalid_argument("Cannot erase at null or sentinel iterator position or from empty container.");
         }
 
-        Node<T>* node_to_remove = const_cast<Node<T>*>(pos.current_node);
-        Node<T>* next_node = node_to_remove->next;
+        BaseNode* node_to_remove = const_cast<BaseNode*>(pos.current_node);
+        BaseNode* next_node = node_to_remove->forward(0);
 
         remove_from_skip_list(node_to_remove);
         remove_dll_node(node_to_remove);
@@ -664,15 +1427,16 @@ public:
         while (first != last) {
             first = erase(first);
         }
-        return iterator(const_cast<Node<T>*>(last.current_node));
+        return iterator(const_cast<BaseNode*>(last.current_node));
     }
 
+    // Значение <= front() встает в начало без поиска, остальные - как insert().
     void push_front(const value_type& value) {
-        insert(end(), value);
+        push_front_node(allocate_and_construct_node(value, next_node_level()));
     }
 
     void push_front(value_type&& value) {
-        insert(end(), std::move(value));
+        push_front_node(allocate_and_construct_node(std::move(value), next_node_level()));
     }
 
     void pop_front() {
@@ -682,52 +1446,300 @@ public:
         erase(begin());
     }
 
+    // Значение >= back() (возрастающие метки времени и т.п.) пристегивается к хвостам
+    // уровней без поиска, за O(1); равные back() встают после него.
     void push_back(const value_type& value) {
-        insert(end(), value);
+        push_back_node(allocate_and_construct_node(value, next_node_level()));
     }
 
     void push_back(value_type&& value) {
-        insert(end(), std::move(value));
+        push_back_node(allocate_and_construct_node(std::move(value), next_node_level()));
     }
 
     void pop_back() {
         if (empty()) {
             throw std::out_of_range("pop_back() called on empty container.");
         }
-        erase(--end());
+        erase(iterator(last_node()));
     }
 
     void swap(Container& other) noexcept {
         using std::swap;
-        if (std::allocator_traits<Allocator>::propagate_on_container_swap::value) {
+        if constexpr (std::allocator_traits<Allocator>::propagate_on_container_swap::value) {
             swap(node_allocator, other.node_allocator);
         }
+        swap(compare, other.compare);
         swap(sentinel_node, other.sentinel_node);
         swap(num_elements, other.num_elements);
-        swap(skip_list_heads, other.skip_list_heads);
+        swap(level_tails, other.level_tails);
         swap(current_max_level, other.current_max_level);
+        hot_arena.swap(other.hot_arena);
+        swap_node_storage(other);
+        swap(min_hot_level, other.min_hot_level);
         swap(rng, other.rng);
         swap(dist, other.dist);
     }
 
-    bool contains(const value_type& value) const {
-        return find_node_in_skip_list(value) != nullptr;
+    bool contains(const key_type& key) const {
+        return find_node_in_skip_list(key) != nullptr;
+    }
+
+    iterator find(const key_type& key) {
+        BaseNode* node = find_node_in_skip_list(key);
+        return (node != nullptr) ? iterator(node) : end();
+    }
+
+    const_iterator find(const key_type& key) const {
+        BaseNode* node = find_node_in_skip_list(key);
+        return (node != nullptr) ? const_iterator(node) : cend();
+    }
+
+    // Границы диапазонов ищутся спуском по уровням Skip List за O(log n).
+    // Первый элемент, не меньший key.
+    iterator lower_bound(const key_type& key) {
+        return iterator(lower_bound_node(KeyPolicy::make_probe(key)));
+    }
+
+    const_iterator lower_bound(const key_type& key) const {
+        return const_iterator(lower_bound_node(KeyPolicy::make_probe(key)));
+    }
+
+    // Первый элемент, больший key.
+    iterator upper_bound(const key_type& key) {
+        return iterator(upper_bound_node(KeyPolicy::make_probe(key)));
+    }
+
+    const_iterator upper_bound(const key_type& key) const {
+        return const_iterator(upper_bound_node(KeyPolicy::make_probe(key)));
+    }
+
+    std::pair<iterator, iterator> equal_range(const key_type& key) {
+        const auto probe = KeyPolicy::make_probe(key);
+        return {iterator(lower_bound_node(probe)), iterator(upper_bound_node(probe))};
     }
 
-    iterator find(const value_type& value) {
-        Node<T>* node = find_node_in_skip_list(value);
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        const auto probe = KeyPolicy::make_probe(key);
+        return {const_iterator(lower_bound_node(probe)), const_iterator(upper_bound_node(probe))};
+    }
+
+    // Поиск по ключу другого типа (std::string_view для Container<std::string> и т.п.)
+    // без временного key_type. Как в std::set: только при Compare::is_transparent,
+    // и K должен сравниваться с key_type (иначе работают перегрузки с key_type).
+    template <typename K> requires TRANSPARENT_LOOKUP<K>
+    bool contains(const K& key) const {
+        return find_node_in_skip_list(key) != nullptr;
+    }
+
+    template <typename K> requires TRANSPARENT_LOOKUP<K>
+    iterator find(const K& key) {
+        BaseNode* node = find_node_in_skip_list(key);
         return (node != nullptr) ? iterator(node) : end();
     }
 
-    const_iterator find(const value_type& value) const {
-        Node<T>* node = find_node_in_skip_list(value);
+    template <typename K> requires TRANSPARENT_LOOKUP<K>
+    const_iterator find(const K& key) const {
+        BaseNode* node = find_node_in_skip_list(key);
         return (node != nullptr) ? const_iterator(node) : cend();
     }
+
+    template <typename K> requires TRANSPARENT_LOOKUP<K>
+    iterator lower_bound(const K& key) {
+        return iterator(lower_bound_node(KeyPolicy::make_probe(key)));
+    }
+
+    template <typename K> requires TRANSPARENT_LOOKUP<K>
+    const_iterator lower_bound(const K& key) const {
+        return const_iterator(lower_bound_node(KeyPolicy::make_probe(key)));
+    }
+
+    template <typename K> requires TRANSPARENT_LOOKUP<K>
+    iterator upper_bound(const K& key) {
+        return iterator(upper_bound_node(KeyPolicy::make_probe(key)));
+    }
+
+    template <typename K> requires TRANSPARENT_LOOKUP<K>
+    const_iterator upper_bound(const K& key) const {
+        return const_iterator(upper_bound_node(KeyPolicy::make_probe(key)));
+    }
+
+    template <typename K> requires TRANSPARENT_LOOKUP<K>
+    std::pair<iterator, iterator> equal_range(const K& key) {
+        const auto probe = KeyPolicy::make_probe(key);
+        return {iterator(lower_bound_node(probe)), iterator(upper_bound_node(probe))};
+    }
+
+    template <typename K> requires TRANSPARENT_LOOKUP<K>
+    std::pair<const_iterator, const_iterator> equal_range(const K& key) const {
+        const auto probe = KeyPolicy::make_probe(key);
+        return {const_iterator(lower_bound_node(probe)), const_iterator(upper_bound_node(probe))};
+    }
+
+    // Курсор для серий операций с близкими ключами: слияний, пакетного поиска по
+    // отсортированным ключам, вставки почти упорядоченных данных. Хранит путь
+    // последнего поиска (последний узел меньше ключа на каждом уровне) и начинает
+    // следующий seek/insert/erase с него, а не с вершины списка:
+    //   - путь сверху остается верным, пока следующая связь на уровне не меньше
+    //     нового ключа, поэтому курсор поднимается только на O(log d) уровней,
+    //     где d - расстояние от прошлого ключа; на плотной серии это O(1) на шаг;
+    //   - ключ меньше прошлого - обычный поиск сверху.
+    // Как и итераторы, путь ссылается на узлы: после изменений контейнера в обход
+    // курсора (insert, erase, clear(), defragment(), присваивание, swap) нужен reset().
+    class Cursor {
+    public:
+        explicit Cursor(Container& owner) noexcept : container(&owner) {
+            reset();
+        }
+
+        void reset() noexcept {
+            std::fill(std::begin(path), std::end(path), container->sentinel_node);
+        }
+
+        // Первый элемент, не меньший key, как lower_bound().
+        iterator seek(const key_type& key) {
+            return iterator(advance(KeyPolicy::make_probe(key)));
+        }
+
+        iterator find(const key_type& key) {
+            return find_probe(KeyPolicy::make_probe(key));
+        }
+
+        bool contains(const key_type& key) {
+            return find(key) != container->end();
+        }
+
+        template <typename K> requires TRANSPARENT_LOOKUP<K>
+        iterator seek(const K& key) {
+            return iterator(advance(KeyPolicy::make_probe(key)));
+        }
+
+        template <typename K> requires TRANSPARENT_LOOKUP<K>
+        iterator find(const K& key) {
+            return find_probe(KeyPolicy::make_probe(key));
+        }
+
+        template <typename K> requires TRANSPARENT_LOOKUP<K>
+        bool contains(const K& key) {
+            return find(key) != container->end();
+        }
+
+        // Вставляет после всех меньших элементов, как insert(). Путь остается
+        // верным: новый узел не меньше своего ключа.
+        iterator insert(const value_type& value) {
+            return link(container->allocate_and_construct_node(value, container->next_node_level()));
+        }
+
+        iterator insert(value_type&& value) {
+            return link(container->allocate_and_construct_node(std::move(value), container->next_node_level()));
+        }
+
+        iterator erase(const_iterator pos) {
+            Container& owner = *container;
+            if (pos.current_node == nullptr || pos.current_node == owner.sentinel_node || owner.empty()) {
+                throw std::invalid_argument("Cannot erase at null or sentinel iterator position or from empty container.");
+            }
+
+            BaseNode* node_to_remove = const_cast<BaseNode*>(pos.current_node);
+            BaseNode* next_node = node_to_remove->forward(0);
+            advance(probe_of(node_to_remove));
+
+            // Путь стоит перед всеми равными; среди дубликатов доходим до самого узла
+            BaseNode* update[MAX_SKIP_LEVEL];
+            for (int i = 0; i <= node_to_remove->level; ++i) {
+                BaseNode* current = path[i];
+                while (current->forward(i) != node_to_remove && current->forward(i) != owner.sentinel_node) {
+                    current = current->forward(i);
+                }
+                update[i] = current;
+            }
+
+            owner.unlink_from_skip_list(node_to_remove, update);
+            owner.remove_dll_node(node_to_remove);
+            owner.destroy_and_deallocate_node(node_to_remove);
+            return iterator(next_node);
+        }
+
+    private:
+        Container* container;
+        BaseNode* path[MAX_SKIP_LEVEL];
+
+        // Переставляет путь на probe и возвращает первый узел, не меньший probe.
+        template <typename P>
+        BaseNode* advance(const P& probe) {
+            const Container& owner = *container;
+            int top = owner.current_max_level;
+            if (path[0] == owner.sentinel_node || owner.node_less(path[0], probe)) {
+                // Все узлы пути меньше probe. Если path[i + 1]->forward(i + 1) не меньше
+                // probe, то и на всех уровнях выше следующая связь не меньше: там путь верен.
+                top = 0;
+                while (top < owner.current_max_level && owner.forward_less(path[top + 1], top + 1, probe)) {
+                    ++top;
+                }
+            } else {
+                reset();
+            }
+
+            BaseNode* current = path[top];
+            for (int i = top; i >= 0; --i) {
+                while (owner.forward_less(current, i, probe)) {
+                    current = current->forward(i);
+                }
+                path[i] = current;
+            }
+            return current->forward(0);
+        }
+
+        template <typename P>
+        iterator find_probe(const P& probe) {
+            BaseNode* node = advance(probe);
+            if (node != container->sentinel_node && container->node_equal(node, probe)) {
+                return iterator(node);
+            }
+            return container->end();
+        }
+
+        iterator link(BaseNode* new_node) {
+            advance(probe_of(new_node));
+            // Уровни выше current_max_level в пути - sentinel, как и ждет link_new_node
+            return container->link_new_node(new_node, path);
+        }
+    };
+
+    Cursor cursor() noexcept {
+        return Cursor(*this);
+    }
 };
 
-template <typename T, typename Alloc>
-void swap(Container<T, Alloc>& a, Container<T, Alloc>& b) noexcept {
+template <typename T, typename Alloc, bool Bidirectional, typename KeyPolicy, typename Compare>
+void swap(Container<T, Alloc, Bidirectional, KeyPolicy, Compare>& a,
+          Container<T, Alloc, Bidirectional, KeyPolicy, Compare>& b) noexcept {
     a.swap(b);
 }
 
+template <typename T, typename Allocator = std::allocator<T>>
+using ForwardContainer = Container<T, Allocator, false>;
+
+// Записи, упорядоченные по маленькому ключу KeyOf(value): ключ лежит в узле, запись - отдельно.
+template <typename T, typename KeyOf, typename Allocator = std::allocator<T>>
+using SplitKeyContainer = Container<T, Allocator, true, SplitKey<T, KeyOf>>;
+
+// Поиск по копиям ключей в связях башни, для маленьких тривиально копируемых T.
+template <typename T, typename Allocator = std::allocator<T>>
+using CachedLinkContainer = Container<T, Allocator, true, CachedLinkKey<T>>;
+
+// Контейнеры поверх std::pmr::memory_resource: например, временный контейнер на
+// monotonic_buffer_resource со стековым буфером не обращается к глобальной куче.
+// Узлы, башни, хвосты уровней и значения SplitKey берутся из ресурса, а значения
+// с pmr-аллокатором (std::pmr::string) конструируются с тем же ресурсом.
+namespace pmr {
+
+template <typename T, bool Bidirectional = true, typename KeyPolicy = ValueKey<T>,
+          typename Compare = std::less<typename KeyPolicy::key_type>>
+using Container = ::Container<T, std::pmr::polymorphic_allocator<T>, Bidirectional, KeyPolicy, Compare>;
+
+template <typename T>
+using ForwardContainer = ::ForwardContainer<T, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace pmr
+
 #endif // CONTAINER_CONTAINER_H
\ No newline at end of file
@@ -0,0 +1,216 @@
+// container/nodes/key_policy.h
+#ifndef CONTAINER_NODES_KEY_POLICY_H
+#define CONTAINER_NODES_KEY_POLICY_H
+
+#include <algorithm>   // Для std::min
+#include <cstdint>     // Для std::uint64_t
+#include <cstring>     // Для std::memcpy
+#include <memory>      // Для std::addressof
+#include <functional>  // Для std::less
+#include <string>
+#include <string_view>
+#include <type_traits> // Для std::invoke_result_t
+
+// Политика ключа определяет, что узел Container хранит для поиска и где лежит значение.
+// Интерфейс политики P для значений типа T:
+//   key_type                       - тип, по которому ищут find() и contains()
+//   stored_key                     - копия ключа в узле рядом с башней (EmptyKey - ничего)
+//   probe                          - искомый ключ, подготовленный к сравнениям
+//   VALUE_OUT_OF_LINE              - значение лежит в отдельной аллокации, узел хранит T*
+//   HETEROGENEOUS_LOOKUP           - make_probe принимает любой сравнимый с ключом тип K
+//   OWN_LOOKUP<K> (необязательно)  - K сравнивается самой политикой, без Compare: поиск
+//                                    по K разрешен и с непрозрачным Compare
+//   NATURAL_ORDER_ONLY             - stored_key кодирует порядок operator<, и Compare
+//                                    может быть только std::less
+//   key(value)                     - ключ значения
+//   store(value)                   - stored_key для нового узла
+//   make_probe(key)                - probe по ключу (с HETEROGENEOUS_LOOKUP - шаблон по K)
+//   node_probe(stored, value)      - probe по ключу узла
+//   less(comp, stored, value, probe)  - ключ узла < probe в порядке comp
+//   equal(comp, stored, value, probe) - ключ узла эквивалентен probe
+//   link_key                       - ключ, копируемый в связи башни (void - связи без ключей)
+//   link_of(stored, value)         - link_key узла (только если link_key не void)
+//   link_less(comp, cached, probe) - закэшированный ключ < probe (только если link_key не void)
+// Политика, хранящая ключ в узле, не должна читать value в less/equal: тогда
+// поиск не трогает значения (и холодную память, если оно вынесено из узла).
+
+struct EmptyKey {};
+
+// Compare - это std::less<K> или прозрачный std::less<>.
+template <typename Compare, typename K>
+inline constexpr bool IS_NATURAL_ORDER =
+    std::is_same_v<Compare, std::less<K>> || std::is_same_v<Compare, std::less<>>;
+
+// Container ищет по ключу типа K без временного key_type: политика сравнивает K
+// сама (OWN_LOOKUP) или Compare прозрачен и сравнивает K с key_type в обе стороны.
+template <typename KeyPolicy, typename Compare, typename K>
+constexpr bool can_look_up_by() {
+    using Key = typename KeyPolicy::key_type;
+    if constexpr (!KeyPolicy::HETEROGENEOUS_LOOKUP) {
+        return false;
+    } else if constexpr (requires { KeyPolicy::template OWN_LOOKUP<K>; }) {
+        return KeyPolicy::template OWN_LOOKUP<K>;
+    } else {
+        return requires { typename Compare::is_transparent; }
+            && std::is_invocable_r_v<bool, const Compare&, const Key&, const K&>
+            && std::is_invocable_r_v<bool, const Compare&, const K&, const Key&>;
+    }
+}
+
+template <typename KeyPolicy, typename Compare, typename K>
+inline constexpr bool CAN_LOOK_UP_BY = can_look_up_by<KeyPolicy, Compare, K>();
+
+// Ключ - само значение, узел ничего не хранит, все сравнения идут через Compare.
+// Эквивалентность, как в std::set, - !(a < b) && !(b < a). Подходит для любого
+// Compare, в том числе для типов, у которых ValueKey<T> кодирует порядок в узле.
+template <typename T>
+struct PlainValueKey {
+    using key_type = T;
+    using stored_key = EmptyKey;
+    using probe = const T*;
+    using link_key = void;
+    static constexpr bool VALUE_OUT_OF_LINE = false;
+    static constexpr bool HETEROGENEOUS_LOOKUP = true;
+    static constexpr bool NATURAL_ORDER_ONLY = false;
+
+    static const key_type& key(const T& value) noexcept { return value; }
+    static stored_key store(const T&) noexcept { return {}; }
+    template <typename K>
+    static const K* make_probe(const K& key) noexcept { return std::addressof(key); }
+    static probe node_probe(const stored_key&, const T& value) noexcept { return std::addressof(value); }
+
+    template <typename Compare, typename K>
+    static bool less(const Compare& comp, const stored_key&, const T& value, const K* p) {
+        return comp(value, *p);
+    }
+
+    template <typename Compare, typename K>
+    static bool equal(const Compare& comp, const stored_key&, const T& value, const K* p) {
+        return !comp(value, *p) && !comp(*p, value);
+    }
+};
+
+// По умолчанию ключ - само значение (ниже специализации для отдельных типов).
+template <typename T>
+struct ValueKey : PlainValueKey<T> {};
+
+// Сокращенный ключ для строк: узел хранит первые 8 байт строки как big-endian
+// число (недостающие байты - нули). Порядок таких чисел совпадает с порядком
+// std::string (char_traits<char> сравнивает байты как unsigned char), поэтому
+// сравнение префиксов решает почти все шаги поиска, а буфер строки в куче
+// читается только при равных префиксах. Искать можно по всему, что приводится
+// к std::string_view (const char*, string_view), без временной std::string.
+struct StringPrefixKey {
+    struct Probe {
+        std::uint64_t prefix;
+        std::string_view key;
+    };
+
+    using key_type = std::string;
+    using stored_key = std::uint64_t;
+    using probe = Probe;
+    using link_key = void;
+    static constexpr bool VALUE_OUT_OF_LINE = false;
+    static constexpr bool HETEROGENEOUS_LOOKUP = true;
+    static constexpr bool NATURAL_ORDER_ONLY = true;
+    // Сравнение идет по string_view, Compare не участвует
+    template <typename K>
+    static constexpr bool OWN_LOOKUP = std::is_convertible_v<const K&, std::string_view>;
+
+    static std::uint64_t prefix_of(std::string_view s) noexcept {
+        unsigned char bytes[8] = {};
+        std::memcpy(bytes, s.data(), std::min<std::size_t>(s.size(), sizeof(bytes)));
+        std::uint64_t prefix = 0;
+        for (unsigned char byte : bytes) {
+            prefix = (prefix << 8) | byte;
+        }
+        return prefix;
+    }
+
+    static const key_type& key(const std::string& value) noexcept { return value; }
+    static stored_key store(const std::string& value) noexcept { return prefix_of(value); }
+    template <typename K>
+    static probe make_probe(const K& key) noexcept {
+        const std::string_view view(key);
+        return {prefix_of(view), view};
+    }
+    static probe node_probe(const stored_key& stored, const std::string& value) noexcept {
+        return {stored, value};
+    }
+
+    template <typename Compare>
+    static bool less(const Compare&, const stored_key& stored, const std::string& value, const probe& p) {
+        if (stored != p.prefix) {
+            return stored < p.prefix;
+        }
+        return std::string_view(value) < p.key;
+    }
+
+    template <typename Compare>
+    static bool equal(const Compare&, const stored_key& stored, const std::string& value, const probe& p) {
+        return stored == p.prefix && std::string_view(value) == p.key;
+    }
+};
+
+// Container<std::string> по умолчанию ищет по префиксам.
+template <>
+struct ValueKey<std::string> : StringPrefixKey {};
+
+// Политика, с которой Container работает при данном Compare. ValueKey<T>,
+// кодирующий в узле порядок operator< (как ValueKey<std::string>), с другим
+// Compare заменяется на PlainValueKey<T>; явно выбранные политики не подменяются.
+template <typename KeyPolicy, typename T, typename Compare>
+using KeyPolicyFor = std::conditional_t<
+    std::is_same_v<KeyPolicy, ValueKey<T>> && KeyPolicy::NATURAL_ORDER_ONLY
+        && !IS_NATURAL_ORDER<Compare, typename KeyPolicy::key_type>,
+    PlainValueKey<T>, KeyPolicy>;
+
+// Hot/cold split: ключ, извлеченный KeyOf, хранится в узле сразу за башней,
+// а само значение - в отдельной аллокации. Поиск читает только узлы с ключами,
+// поэтому большие записи с маленьким ключом не загрязняют кэш.
+// Ключ копируется при вставке: изменять его поля через итератор нельзя.
+template <typename T, typename KeyOf>
+struct SplitKey {
+    using key_type = std::decay_t<std::invoke_result_t<const KeyOf&, const T&>>;
+    using stored_key = key_type;
+    using probe = const key_type*;
+    using link_key = void;
+    static constexpr bool VALUE_OUT_OF_LINE = true;
+    static constexpr bool HETEROGENEOUS_LOOKUP = true;
+    static constexpr bool NATURAL_ORDER_ONLY = false;
+
+    static key_type key(const T& value) { return KeyOf{}(value); }
+    static stored_key store(const T& value) { return KeyOf{}(value); }
+    template <typename K>
+    static const K* make_probe(const K& key) noexcept { return std::addressof(key); }
+    static probe node_probe(const stored_key& stored, const T&) noexcept { return std::addressof(stored); }
+
+    template <typename Compare, typename K>
+    static bool less(const Compare& comp, const stored_key& stored, const T&, const K* p) {
+        return comp(stored, *p);
+    }
+
+    template <typename Compare, typename K>
+    static bool equal(const Compare& comp, const stored_key& stored, const T&, const K* p) {
+        return !comp(stored, *p) && !comp(*p, stored);
+    }
+};
+
+// Толстые связи: каждый уровень башни хранит рядом с указателем копию ключа
+// следующего узла, и поиск сравнивает с ней, не обращаясь к следующему узлу
+// (один промах кэша на шаг меньше). Башня вдвое больше, поэтому режим
+// рассчитан на маленькие тривиально копируемые ключи вроде int64_t.
+template <typename T>
+struct CachedLinkKey : ValueKey<T> {
+    static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= 8,
+                  "CachedLinkKey is meant for small trivially copyable keys");
+
+    using link_key = T;
+
+    static link_key link_of(const EmptyKey&, const T& value) noexcept { return value; }
+
+    template <typename Compare, typename K>
+    static bool link_less(const Compare& comp, const link_key& cached, const K* p) { return comp(cached, *p); }
+};
+
+#endif // CONTAINER_NODES_KEY_POLICY_H
@@ -3,16 +3,49 @@
 #define CONTAINER_NODES_NODE_H
 
 #include <cstddef> // Для std::size_t
+#include <cstdint> // Для std::uint8_t
+#include <type_traits> // Для std::conditional_t
 #include <utility> // Для std::move
 
-template <typename T>
-struct Node {
-    T value;
-    Node<T>* next; // For DLL part
-    Node<T>* prev; // For DLL part
-    Node<T>** forward; // For Skip List part
-    int level;
-    bool is_sentinel; // True if it's the sentinel node
+#include "container/nodes/key_policy.h"
+
+// Заголовок узла без значения: связи DLL, уровень и башня Skip List.
+// Sentinel - это голый NodeBase, поэтому контейнеру не нужно конструировать T
+// (и T не обязан быть default-constructible).
+//
+// Раскладка блока в памяти: [padding][forward(level) ... forward(0)][NodeBase][T value]
+// Башня из (level + 1) указателей лежит непосредственно перед заголовком, в той же
+// аллокации, поэтому forward(0) и value соседствуют в одной кэш-линии.
+//
+// Заголовок компактный: прямой связью DLL служит forward(0) (уровень 0 Skip List
+// содержит все узлы по порядку), уровень хранится в одном байте, а sentinel
+// отличается от обычного узла значением level == MAX_NODE_LEVEL. Для T = int64_t
+// узел нулевого уровня занимает 32 байта вместе с башней.
+//
+// При Bidirectional == false указатель prev не хранится вовсе (односвязный режим),
+// и тот же узел занимает 24 байта.
+//
+// Если LinkKey не void, каждый уровень башни - "толстая" связь {указатель, копия
+// ключа следующего узла}: поиск решает, идти ли дальше, не читая следующий узел.
+struct NoPrevLink {};
+
+template <typename NodePointer, typename LinkKey>
+struct FatLink {
+    static_assert(std::is_trivially_copyable_v<LinkKey> && alignof(LinkKey) <= alignof(NodePointer),
+                  "Cached link keys must be small trivially copyable types");
+
+    NodePointer next;
+    LinkKey key;
+};
+
+template <bool Bidirectional = true, typename LinkKey = void>
+struct NodeBase {
+    using PrevLink = std::conditional_t<Bidirectional, NodeBase*, NoPrevLink>;
+    static constexpr bool HAS_LINK_KEYS = !std::is_void_v<LinkKey>;
+    using Link = std::conditional_t<HAS_LINK_KEYS, FatLink<NodeBase*, LinkKey>, NodeBase*>;
+
+    [[no_unique_address]] PrevLink prev; // For DLL part
+    std::uint8_t level;
 
     // Убедитесь, что MAX_SKIP_LEVEL определен где-то, например, в Container
     // или передан как параметр шаблона в Node, если Node не инстанцируется в Container.
@@ -21,44 +54,141 @@ struct Node {
     // Допустим, она будет 16, как в Container.
     static constexpr int MAX_NODE_LEVEL = 16; // Должен совпадать с Container::MAX_SKIP_LEVEL
 
+    // Constructor for sentinel node: башня из MAX_NODE_LEVEL уровней
+    NodeBase() noexcept : NodeBase(MAX_NODE_LEVEL) {}
+
     // Constructor for regular nodes
-    Node(const T& val, int node_level) :
-        value(val), next(nullptr), prev(nullptr), level(node_level), is_sentinel(false) {
-        forward = new Node<T>*[MAX_NODE_LEVEL]; // Выделяем память для всех уровней
-        for (int i = 0; i < MAX_NODE_LEVEL; ++i) { // Инициализируем все nullptr
-            forward[i] = nullptr;
+    explicit NodeBase(int node_level) noexcept :
+        prev(), level(static_cast<std::uint8_t>(node_level)) {
+        for (int i = 0; i <= tower_level(); ++i) { // Инициализируем все nullptr
+            forward(i) = nullptr;
+            if constexpr (HAS_LINK_KEYS) {
+                link_key(i) = LinkKey{};
+            }
         }
     }
 
-    // Constructor for regular nodes (move)
-    Node(T&& val, int node_level) :
-        value(std::move(val)), next(nullptr), prev(nullptr), level(node_level), is_sentinel(false) {
-        forward = new Node<T>*[MAX_NODE_LEVEL];
-        for (int i = 0; i < MAX_NODE_LEVEL; ++i) {
-            forward[i] = nullptr;
+    bool is_sentinel() const noexcept {
+        return level == MAX_NODE_LEVEL;
+    }
+
+    // Верхний уровень башни (у sentinel - MAX_NODE_LEVEL - 1).
+    int tower_level() const noexcept {
+        return is_sentinel() ? MAX_NODE_LEVEL - 1 : level;
+    }
+
+    // Skip List part: i-й уровень башни.
+    NodeBase*& forward(int i) noexcept {
+        if constexpr (HAS_LINK_KEYS) {
+            return link(i).next;
+        } else {
+            return link(i);
         }
     }
 
-    // Constructor for sentinel node
-    Node(bool sentinel = true, int node_level = MAX_NODE_LEVEL) : // Sentinel всегда имеет MAX_NODE_LEVEL
-        value(T()), next(nullptr), prev(nullptr), level(node_level), is_sentinel(sentinel) {
-        forward = new Node<T>*[MAX_NODE_LEVEL];
-        for (int i = 0; i < MAX_NODE_LEVEL; ++i) { // Инициализируем все nullptr
-            forward[i] = nullptr;
+    NodeBase* forward(int i) const noexcept {
+        if constexpr (HAS_LINK_KEYS) {
+            return link(i).next;
+        } else {
+            return link(i);
         }
     }
 
-    ~Node() {
-        delete[] forward;
+    // Копия ключа узла forward(i); у связи на sentinel не определена.
+    template <typename K = LinkKey>
+    std::enable_if_t<!std::is_void_v<K>, K&> link_key(int i) noexcept {
+        return link(i).key;
+    }
+
+    template <typename K = LinkKey>
+    std::enable_if_t<!std::is_void_v<K>, const K&> link_key(int i) const noexcept {
+        return link(i).key;
+    }
+
+    Link& link(int i) noexcept {
+        return reinterpret_cast<Link*>(this)[-1 - i];
+    }
+
+    const Link& link(int i) const noexcept {
+        return reinterpret_cast<const Link*>(this)[-1 - i];
+    }
+
+    // Смещение заголовка от начала блока: башня, выровненная под NodeType.
+    template <typename NodeType>
+    static constexpr std::size_t tower_bytes(int node_level) noexcept {
+        const std::size_t bytes = static_cast<std::size_t>(node_level + 1) * sizeof(Link);
+        return (bytes + alignof(NodeType) - 1) / alignof(NodeType) * alignof(NodeType);
     }
 
     // Удаляем конструктор копирования и оператор присваивания копированием,
     // чтобы избежать двойного удаления или некорректного копирования.
     // Nodes должны управляться аллокатором контейнера.
-    Node(const Node&) = delete;
-    Node& operator=(const Node&) = delete;
-    Node(Node&&) = delete;
-    Node& operator=(Node&&) = delete;
+    NodeBase(const NodeBase&) = delete;
+    NodeBase& operator=(const NodeBase&) = delete;
+    NodeBase(NodeBase&&) = delete;
+    NodeBase& operator=(NodeBase&&) = delete;
+};
+
+// KeyPolicy (см. key_policy.h) задает ключ, хранимый рядом с башней, и то,
+// лежит ли значение в узле или в отдельной аллокации (тогда value - это T*).
+template <typename T, bool Bidirectional = true, typename KeyPolicy = ValueKey<T>>
+struct Node : NodeBase<Bidirectional, typename KeyPolicy::link_key> {
+    using Base = NodeBase<Bidirectional, typename KeyPolicy::link_key>;
+
+    static constexpr bool VALUE_OUT_OF_LINE = KeyPolicy::VALUE_OUT_OF_LINE;
+
+    [[no_unique_address]] typename KeyPolicy::stored_key key;
+    std::conditional_t<VALUE_OUT_OF_LINE, T*, T> value;
+
+    // Constructor for regular nodes
+    Node(const T& val, int node_level) requires (!VALUE_OUT_OF_LINE) :
+        Base(node_level), key(KeyPolicy::store(val)), value(val) {}
+
+    // Constructor for regular nodes (move)
+    Node(T&& val, int node_level) requires (!VALUE_OUT_OF_LINE) :
+        Base(node_level), key(KeyPolicy::store(val)), value(std::move(val)) {}
+
+    // Constructor for nodes with an out-of-line value
+    Node(T* payload, int node_level) requires VALUE_OUT_OF_LINE :
+        Base(node_level), key(KeyPolicy::store(*payload)), value(payload) {}
+
+    T& get() noexcept {
+        if constexpr (VALUE_OUT_OF_LINE) {
+            return *value;
+        } else {
+            return value;
+        }
+    }
+
+    const T& get() const noexcept {
+        if constexpr (VALUE_OUT_OF_LINE) {
+            return *value;
+        } else {
+            return value;
+        }
+    }
+};
+
+// Единица выделения памяти под узел вместе с его башней. Контейнер выделяет
+// узлы массивами NodeStorage<T> через свой аллокатор, поэтому размер блока
+// кратен выравниванию узла, а не sizeof(Node<T>). Единица выровнена не слабее
+// указателя: с нее начинается башня (у ForwardContainer<int> сам узел выровнен по 4).
+template <typename NodeType>
+inline constexpr std::size_t NODE_STORAGE_ALIGNMENT =
+    alignof(NodeType) > alignof(void*) ? alignof(NodeType) : alignof(void*);
+
+template <typename T, bool Bidirectional = true, typename KeyPolicy = ValueKey<T>>
+struct alignas(NODE_STORAGE_ALIGNMENT<Node<T, Bidirectional, KeyPolicy>>) NodeStorage {
+    unsigned char bytes[NODE_STORAGE_ALIGNMENT<Node<T, Bidirectional, KeyPolicy>>];
+
+    // Количество элементов NodeStorage<T> под NodeType (Node<T> или sentinel NodeBase)
+    // с башней уровня node_level.
+    template <typename NodeType>
+    static constexpr std::size_t units(int node_level) noexcept {
+        return (NodeBase<Bidirectional, typename KeyPolicy::link_key>::template tower_bytes<NodeType>(node_level)
+                + sizeof(NodeType)
+                + sizeof(NodeStorage) - 1) / sizeof(NodeStorage);
+    }
 };
 
-#endif // CONTAINER_NODES_NODE_H
\ No newline at end of file
+#endif // CONTAINER_NODES_NODE_H
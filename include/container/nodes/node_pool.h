@@ -0,0 +1,83 @@
+// container/nodes/node_pool.h
+#ifndef CONTAINER_NODES_NODE_POOL_H
+#define CONTAINER_NODES_NODE_POOL_H
+
+#include <cstddef>
+#include <utility>
+
+// Пул свободных блоков под узлы, по спискам на каждую высоту башни. Блоки
+// одной высоты имеют одинаковый размер, поэтому любой из них подходит новому
+// узлу этой высоты. Пул не владеет памятью: блоки выделяет и возвращает
+// аллокатору Container (drain), пул только хранит их между вставками.
+template <typename Storage, int Levels>
+class NodePool {
+public:
+    NodePool() noexcept : heads(), counts(), total(0) {}
+
+    NodePool(NodePool&& other) noexcept : NodePool() {
+        swap(other);
+    }
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    NodePool& operator=(NodePool&&) = delete;
+
+    void push(int level, Storage* block) noexcept {
+        FreeBlock* free_block = reinterpret_cast<FreeBlock*>(block);
+        free_block->next = heads[level];
+        heads[level] = free_block;
+        counts[level]++;
+        total++;
+    }
+
+    // nullptr, если блоков этой высоты нет.
+    Storage* pop(int level) noexcept {
+        FreeBlock* block = heads[level];
+        if (block == nullptr) {
+            return nullptr;
+        }
+        heads[level] = block->next;
+        counts[level]--;
+        total--;
+        return reinterpret_cast<Storage*>(block);
+    }
+
+    std::size_t count(int level) const noexcept {
+        return counts[level];
+    }
+
+    std::size_t size() const noexcept {
+        return total;
+    }
+
+    // Отдает все блоки deallocate(block, level) и опустошает пул.
+    template <typename Deallocate>
+    void drain(Deallocate&& deallocate) noexcept {
+        for (int level = 0; level < Levels; ++level) {
+            while (Storage* block = pop(level)) {
+                deallocate(block, level);
+            }
+        }
+    }
+
+    void swap(NodePool& other) noexcept {
+        using std::swap;
+        swap(heads, other.heads);
+        swap(counts, other.counts);
+        swap(total, other.total);
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static_assert(alignof(Storage) >= alignof(FreeBlock),
+                  "A pooled block must be able to hold a free-list link");
+
+    FreeBlock* heads[Levels];
+    std::size_t counts[Levels];
+    std::size_t total;
+};
+
+#endif // CONTAINER_NODES_NODE_POOL_H
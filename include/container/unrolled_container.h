@@ -0,0 +1,742 @@
+#ifndef CONTAINER_UNROLLED_CONTAINER_H
+#define CONTAINER_UNROLLED_CONTAINER_H
+
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <initializer_list>
+#include <type_traits>
+#include <algorithm>
+#include <random>
+#include <chrono>
+
+#include "container/nodes/node.h"
+
+// Блок развернутого Skip List: заголовок узла (башня перед ним, prev) и до
+// Capacity отсортированных элементов подряд. Башни индексируют блоки по их
+// первому элементу.
+template <typename T, std::size_t Capacity>
+struct UnrolledNode : NodeBase<true> {
+    std::size_t count;
+    alignas(T) unsigned char elements[Capacity * sizeof(T)];
+
+    explicit UnrolledNode(int node_level) noexcept : NodeBase<true>(node_level), count(0) {}
+
+    T* data() noexcept {
+        return std::launder(reinterpret_cast<T*>(elements));
+    }
+
+    const T* data() const noexcept {
+        return std::launder(reinterpret_cast<const T*>(elements));
+    }
+
+    bool full() const noexcept {
+        return count == Capacity;
+    }
+};
+
+template <typename T, std::size_t Capacity>
+struct alignas(alignof(UnrolledNode<T, Capacity>)) UnrolledNodeStorage {
+    unsigned char bytes[alignof(UnrolledNode<T, Capacity>)];
+
+    template <typename NodeType>
+    static constexpr std::size_t units(int node_level) noexcept {
+        return (NodeBase<true>::tower_bytes<NodeType>(node_level) + sizeof(NodeType)
+                + sizeof(UnrolledNodeStorage) - 1) / sizeof(UnrolledNodeStorage);
+    }
+};
+
+// Развернутый вариант Container: элементы хранятся отсортированными массивами по
+// BlockCapacity штук в узлах нулевого уровня, поэтому выделений памяти и переходов
+// по указателям примерно в BlockCapacity раз меньше, а обход почти последовательный.
+// Итератор - пара (блок, позиция в блоке). Вставка и удаление сдвигают элементы
+// внутри блока, поэтому инвалидируют итераторы на элементы того же блока.
+template <typename T, typename Allocator = std::allocator<T>, std::size_t BlockCapacity = 32>
+class UnrolledContainer {
+    static_assert(BlockCapacity >= 2, "A block must hold at least two elements to be split");
+
+    using BaseNode = NodeBase<true>;
+    using BlockNode = UnrolledNode<T, BlockCapacity>;
+    using Storage = UnrolledNodeStorage<T, BlockCapacity>;
+
+public:
+    using value_type = T;
+    using key_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = typename std::allocator_traits<Allocator>::pointer;
+    using const_pointer = typename std::allocator_traits<Allocator>::const_pointer;
+
+    static constexpr size_type block_capacity = BlockCapacity;
+
+    template <bool IsConst>
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = UnrolledContainer::value_type;
+        using difference_type = UnrolledContainer::difference_type;
+        using pointer = std::conditional_t<IsConst, UnrolledContainer::const_pointer, UnrolledContainer::pointer>;
+        using reference = std::conditional_t<IsConst, UnrolledContainer::const_reference, UnrolledContainer::reference>;
+
+        using NodePointer = std::conditional_t<IsConst, const BaseNode*, BaseNode*>;
+        using BlockPointer = std::conditional_t<IsConst, const BlockNode*, BlockNode*>;
+
+    private:
+        NodePointer current_block;
+        size_type offset;
+
+        friend class UnrolledContainer;
+        template <bool> friend class Iterator;
+
+        Iterator(NodePointer block, size_type pos) : current_block(block), offset(pos) {}
+
+        BlockPointer block() const noexcept {
+            return static_cast<BlockPointer>(current_block);
+        }
+
+    public:
+        Iterator() : current_block(nullptr), offset(0) {}
+
+        template<bool OtherIsConst, typename = std::enable_if_t<OtherIsConst || !IsConst>>
+        Iterator(const Iterator<OtherIsConst>& other) noexcept :
+            current_block(const_cast<NodePointer>(other.current_block)), offset(other.offset) {}
+
+        operator Iterator<true>() const noexcept {
+            return Iterator<true>(current_block, offset);
+        }
+
+        reference operator*() const {
+            if (!current_block || current_block->is_sentinel()) {
+                throw std::out_of_range("Dereferencing invalid iterator or sentinel.");
+            }
+            return block()->data()[offset];
+        }
+
+        pointer operator->() const {
+            return std::addressof(**this);
+        }
+
+        Iterator& operator++() {
+            if (!current_block) {
+                throw std::out_of_range("Incrementing null iterator.");
+            }
+            if (current_block->is_sentinel() || ++offset == block()->count) {
+                current_block = current_block->forward(0);
+                offset = 0;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        Iterator& operator--() {
+            if (!current_block) {
+                throw std::out_of_range("Decrementing null iterator.");
+            }
+            if (offset == 0) {
+                current_block = current_block->prev;
+                offset = current_block->is_sentinel() ? 0 : block()->count - 1;
+            } else {
+                --offset;
+            }
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator temp = *this;
+            --(*this);
+            return temp;
+        }
+
+        bool operator==(const Iterator& other) const noexcept {
+            return current_block == other.current_block && offset == other.offset;
+        }
+
+        bool operator!=(const Iterator& other) const noexcept {
+            return !(*this == other);
+        }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+private:
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Storage>;
+    NodeAllocator node_allocator;
+
+    BaseNode* sentinel_node; // Не содержит элементов
+    size_type num_elements;
+
+    static constexpr int MAX_SKIP_LEVEL = BaseNode::MAX_NODE_LEVEL;
+    int current_max_level;
+
+    mutable std::mt19937 rng;
+    mutable std::uniform_real_distribution<double> dist;
+
+    static BlockNode* as_block(BaseNode* node) noexcept {
+        return static_cast<BlockNode*>(node);
+    }
+
+    static const BlockNode* as_block(const BaseNode* node) noexcept {
+        return static_cast<const BlockNode*>(node);
+    }
+
+    static const value_type& first_of(const BaseNode* node) noexcept {
+        return as_block(node)->data()[0];
+    }
+
+    void initialize_container() {
+        sentinel_node = allocate_and_construct<BaseNode>(MAX_SKIP_LEVEL - 1);
+        reset_skip_list();
+
+        rng.seed(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+        dist = std::uniform_real_distribution<double>(0.0, 1.0);
+    }
+
+    void reset_skip_list() noexcept {
+        sentinel_node->prev = sentinel_node;
+        for (int i = 0; i < MAX_SKIP_LEVEL; ++i) {
+            sentinel_node->forward(i) = sentinel_node;
+        }
+        current_max_level = 0;
+        num_elements = 0;
+    }
+
+    template <typename NodeType, typename... Args>
+    NodeType* allocate_and_construct(int level, Args&&... args) {
+        const std::size_t units = Storage::template units<NodeType>(level);
+        Storage* storage = std::allocator_traits<NodeAllocator>::allocate(node_allocator, units);
+        NodeType* new_node = reinterpret_cast<NodeType*>(
+            reinterpret_cast<unsigned char*>(storage) + BaseNode::template tower_bytes<NodeType>(level));
+        std::allocator_traits<NodeAllocator>::construct(node_allocator, new_node, std::forward<Args>(args)...);
+        return new_node;
+    }
+
+    template <typename NodeType>
+    void destroy_and_deallocate(NodeType* node) noexcept {
+        const int level = node->tower_level();
+        unsigned char* block = reinterpret_cast<unsigned char*>(node) - BaseNode::template tower_bytes<NodeType>(level);
+        std::allocator_traits<NodeAllocator>::destroy(node_allocator, node);
+        std::allocator_traits<NodeAllocator>::deallocate(node_allocator, reinterpret_cast<Storage*>(block),
+                                                         Storage::template units<NodeType>(level));
+    }
+
+    void destroy_block(BlockNode* block) noexcept {
+        std::destroy_n(block->data(), block->count);
+        destroy_and_deallocate(block);
+    }
+
+    void destroy_blocks() noexcept {
+        BaseNode* current = sentinel_node->forward(0);
+        while (current != sentinel_node) {
+            BaseNode* next_block = current->forward(0);
+            destroy_block(as_block(current));
+            current = next_block;
+        }
+    }
+
+    void destroy_container_nodes() noexcept {
+        if (sentinel_node == nullptr) {
+            return;
+        }
+        destroy_blocks();
+        destroy_and_deallocate(sentinel_node);
+        sentinel_node = nullptr;
+    }
+
+    void copy_container_nodes_from(const UnrolledContainer& other) {
+        for (const auto& val : other) {
+            push_back(val);
+        }
+    }
+
+    int get_random_level() const {
+        int level = 0;
+        while (dist(rng) < 0.5 && level < MAX_SKIP_LEVEL - 1) {
+            level++;
+        }
+        return level;
+    }
+
+    // Последний блок, первый элемент которого < key (или sentinel), и путь к нему.
+    BaseNode* find_block_before(const key_type& key, BaseNode** update) const {
+        BaseNode* current = sentinel_node;
+        for (int i = current_max_level; i >= 0; --i) {
+            while (current->forward(i) != sentinel_node && first_of(current->forward(i)) < key) {
+                current = current->forward(i);
+            }
+            if (update != nullptr) {
+                update[i] = current;
+            }
+        }
+        return current;
+    }
+
+    // Позиция первого элемента >= key.
+    const_iterator lower_bound_position(const key_type& key) const {
+        BaseNode* block = find_block_before(key, nullptr);
+        if (block == sentinel_node) {
+            return const_iterator(sentinel_node->forward(0), 0);
+        }
+        const BlockNode* node = as_block(block);
+        const size_type pos = static_cast<size_type>(
+            std::lower_bound(node->data(), node->data() + node->count, key) - node->data());
+        if (pos == node->count) {
+            return const_iterator(block->forward(0), 0);
+        }
+        return const_iterator(block, pos);
+    }
+
+    // Пустой блок с башней случайной высоты, еще не связанный со списком.
+    BlockNode* allocate_block() {
+        const int level = get_random_level();
+        return allocate_and_construct<BlockNode>(level, level);
+    }
+
+    // new_block встает сразу за block; update[i] - предшественники block на уровнях выше его башни.
+    void link_block_after(BaseNode* block, BlockNode* new_block, BaseNode** update) noexcept {
+        if (new_block->level > current_max_level) {
+            for (int i = current_max_level + 1; i <= new_block->level; ++i) {
+                update[i] = sentinel_node;
+            }
+            current_max_level = new_block->level;
+        }
+        for (int i = 0; i <= new_block->level; ++i) {
+            BaseNode* predecessor = (block != sentinel_node && i <= block->level) ? block : update[i];
+            new_block->forward(i) = predecessor->forward(i);
+            predecessor->forward(i) = new_block;
+        }
+        new_block->prev = block;
+        new_block->forward(0)->prev = new_block;
+    }
+
+    // Блок из одного значения сразу за block. Значение конструируется до связывания:
+    // если конструктор бросит, блок освобождается и пустых блоков в списке не бывает.
+    template <typename V>
+    BlockNode* link_new_block(BaseNode* block, BaseNode** update, V&& value) {
+        BlockNode* new_block = allocate_block();
+        try {
+            ::new (static_cast<void*>(new_block->data())) T(std::forward<V>(value));
+        } catch (...) {
+            destroy_and_deallocate(new_block);
+            throw;
+        }
+        new_block->count = 1;
+        link_block_after(block, new_block, update);
+        return new_block;
+    }
+
+    void unlink_block(BaseNode* block) noexcept {
+        BaseNode* update[MAX_SKIP_LEVEL];
+        BaseNode* current = sentinel_node;
+        const value_type& first = first_of(block);
+
+        for (int i = current_max_level; i >= 0; --i) {
+            while (current->forward(i) != sentinel_node && first_of(current->forward(i)) < first) {
+                current = current->forward(i);
+            }
+            // Среди блоков с равным первым элементом доходим до удаляемого
+            if (i <= block->level) {
+                while (current->forward(i) != block && current->forward(i) != sentinel_node) {
+                    current = current->forward(i);
+                }
+            }
+            update[i] = current;
+        }
+
+        for (int i = 0; i <= block->level; ++i) {
+            if (update[i]->forward(i) == block) {
+                update[i]->forward(i) = block->forward(i);
+            }
+        }
+        block->forward(0)->prev = block->prev;
+
+        while (current_max_level > 0 && sentinel_node->forward(current_max_level) == sentinel_node) {
+            current_max_level--;
+        }
+    }
+
+    // Сдвигает [pos, count) блока на одну позицию вправо и конструирует значение в pos.
+    template <typename V>
+    static void insert_into_block(BlockNode* block, size_type pos, V&& value) {
+        T* data = block->data();
+        if (pos == block->count) {
+            ::new (static_cast<void*>(data + pos)) T(std::forward<V>(value));
+        } else {
+            T temp(std::forward<V>(value));
+            ::new (static_cast<void*>(data + block->count)) T(std::move(data[block->count - 1]));
+            std::move_backward(data + pos, data + block->count - 1, data + block->count);
+            data[pos] = std::move(temp);
+        }
+        block->count++;
+    }
+
+    static void erase_from_block(BlockNode* block, size_type pos) {
+        T* data = block->data();
+        std::move(data + pos + 1, data + block->count, data + pos);
+        std::destroy_at(data + block->count - 1);
+        block->count--;
+    }
+
+    // Переносит верхнюю половину full_block в новый блок сразу за ним. Половина
+    // переносится (move_if_noexcept) в еще не связанный блок: если это бросит,
+    // блок освобождается, а full_block остается нетронутым.
+    BlockNode* split_block(BlockNode* full_block, BaseNode** update) {
+        BlockNode* new_block = allocate_block();
+        const size_type keep = full_block->count / 2;
+        T* from = full_block->data();
+        try {
+            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+                std::uninitialized_move(from + keep, from + full_block->count, new_block->data());
+            } else {
+                std::uninitialized_copy(from + keep, from + full_block->count, new_block->data());
+            }
+        } catch (...) {
+            destroy_and_deallocate(new_block);
+            throw;
+        }
+        new_block->count = full_block->count - keep;
+        std::destroy(from + keep, from + full_block->count);
+        full_block->count = keep;
+        link_block_after(full_block, new_block, update);
+        return new_block;
+    }
+
+    template <typename V>
+    iterator insert_value(V&& value) {
+        BaseNode* update[MAX_SKIP_LEVEL];
+        BaseNode* block = find_block_before(value, update);
+
+        if (sentinel_node->forward(0) == sentinel_node) {
+            BlockNode* first_block = link_new_block(sentinel_node, update, std::forward<V>(value));
+            num_elements++;
+            return iterator(first_block, 0);
+        }
+
+        // Значение меньше всех первых элементов - оно становится началом первого блока
+        if (block == sentinel_node) {
+            block = sentinel_node->forward(0);
+        }
+
+        BlockNode* target = as_block(block);
+        size_type pos = static_cast<size_type>(
+            std::lower_bound(target->data(), target->data() + target->count, value) - target->data());
+
+        if (target->full()) {
+            if (pos == target->count && target->forward(0) == sentinel_node) {
+                // Дописывание в конец: новый блок вместо деления пополам
+                BlockNode* last_block = link_new_block(target, update, std::forward<V>(value));
+                num_elements++;
+                return iterator(last_block, 0);
+            }
+
+            // value может быть элементом переносимой половины: сначала копия
+            T temp(std::forward<V>(value));
+            BlockNode* upper = split_block(target, update);
+            if (pos > target->count) {
+                pos -= target->count;
+                target = upper;
+            }
+            insert_into_block(target, pos, std::move(temp));
+        } else {
+            insert_into_block(target, pos, std::forward<V>(value));
+        }
+        num_elements++;
+        return iterator(target, pos);
+    }
+
+public:
+    explicit UnrolledContainer(const Allocator& alloc = Allocator()) :
+        node_allocator(alloc),
+        sentinel_node(nullptr),
+        num_elements(0),
+        current_max_level(0)
+    {
+        initialize_container();
+    }
+
+    UnrolledContainer(std::initializer_list<value_type> init, const Allocator& alloc = Allocator()) :
+        UnrolledContainer(alloc)
+    {
+        for (const auto& val : init) {
+            push_back(val);
+        }
+    }
+
+    template <typename InputIt,
+              typename = std::enable_if_t<
+                  std::is_base_of<std::input_iterator_tag,
+                                  typename std::iterator_traits<InputIt>::iterator_category>::value
+              >>
+    UnrolledContainer(InputIt first, InputIt last, const Allocator& alloc = Allocator()) :
+        UnrolledContainer(alloc)
+    {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    UnrolledContainer(const UnrolledContainer& other) :
+        node_allocator(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator())),
+        sentinel_node(nullptr),
+        num_elements(0),
+        current_max_level(0)
+    {
+        initialize_container();
+        copy_container_nodes_from(other);
+    }
+
+    UnrolledContainer(UnrolledContainer&& other) noexcept :
+        node_allocator(std::move(other.node_allocator)),
+        sentinel_node(other.sentinel_node),
+        num_elements(other.num_elements),
+        current_max_level(other.current_max_level),
+        rng(std::move(other.rng)),
+        dist(std::move(other.dist))
+    {
+        other.sentinel_node = nullptr;
+        other.num_elements = 0;
+        other.current_max_level = 0;
+    }
+
+    ~UnrolledContainer() {
+        destroy_container_nodes();
+    }
+
+    UnrolledContainer& operator=(const UnrolledContainer& other) {
+        if (this != &other) {
+            UnrolledContainer copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    UnrolledContainer& operator=(UnrolledContainer&& other) noexcept {
+        if (this != &other) {
+            if (std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value
+                || node_allocator == other.node_allocator) {
+                destroy_container_nodes();
+                if constexpr (std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value) {
+                    node_allocator = std::move(other.node_allocator);
+                }
+                sentinel_node = other.sentinel_node;
+                num_elements = other.num_elements;
+                current_max_level = other.current_max_level;
+                rng = std::move(other.rng);
+                dist = std::move(other.dist);
+
+                other.sentinel_node = nullptr;
+                other.num_elements = 0;
+                other.current_max_level = 0;
+            } else {
+                clear();
+                copy_container_nodes_from(other);
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    UnrolledContainer& operator=(std::initializer_list<value_type> ilist) {
+        clear();
+        for (const auto& val : ilist) {
+            push_back(val);
+        }
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(node_allocator);
+    }
+
+    reference front() {
+        if (empty()) {
+            throw std::out_of_range("front() called on empty container.");
+        }
+        return *begin();
+    }
+
+    const_reference front() const {
+        if (empty()) {
+            throw std::out_of_range("front() called on empty container.");
+        }
+        return *begin();
+    }
+
+    reference back() {
+        if (empty()) {
+            throw std::out_of_range("back() called on empty container.");
+        }
+        return *--end();
+    }
+
+    const_reference back() const {
+        if (empty()) {
+            throw std::out_of_range("back() called on empty container.");
+        }
+        return *--end();
+    }
+
+    iterator begin() noexcept {
+        return iterator(sentinel_node->forward(0), 0);
+    }
+
+    const_iterator begin() const noexcept {
+        return const_iterator(sentinel_node->forward(0), 0);
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    iterator end() noexcept {
+        return iterator(sentinel_node, 0);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(sentinel_node, 0);
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    bool empty() const noexcept {
+        return num_elements == 0;
+    }
+
+    size_type size() const noexcept {
+        return num_elements;
+    }
+
+    size_type max_size() const noexcept {
+        return std::allocator_traits<NodeAllocator>::max_size(node_allocator)
+               / Storage::template units<BlockNode>(0) * BlockCapacity;
+    }
+
+    void clear() noexcept {
+        if (sentinel_node == nullptr) {
+            initialize_container();
+            return;
+        }
+        destroy_blocks();
+        reset_skip_list();
+    }
+
+    // Позиция вставки определяется значением, как и в Container.
+    iterator insert([[maybe_unused]] const_iterator pos, const value_type& value) {
+        return insert_value(value);
+    }
+
+    iterator insert([[maybe_unused]] const_iterator pos, value_type&& value) {
+        return insert_value(std::move(value));
+    }
+
+    iterator erase(const_iterator pos) {
+        if (pos.current_block == nullptr || pos.current_block == sentinel_node || empty()) {
+            throw std::invalid_argument("Cannot erase at null or sentinel iterator position or from empty container.");
+        }
+
+        BlockNode* block = as_block(const_cast<BaseNode*>(pos.current_block));
+        BaseNode* next_block = block->forward(0);
+        num_elements--;
+
+        if (block->count == 1) {
+            unlink_block(block);
+            destroy_block(block);
+            return iterator(next_block, 0);
+        }
+
+        erase_from_block(block, pos.offset);
+        if (pos.offset == block->count) {
+            return iterator(next_block, 0);
+        }
+        return iterator(block, pos.offset);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        // Удаление сдвигает элементы блока, поэтому last пересчитывается по числу удалений.
+        size_type count = static_cast<size_type>(std::distance(first, last));
+        iterator current(const_cast<BaseNode*>(first.current_block), first.offset);
+        while (count-- > 0) {
+            current = erase(current);
+        }
+        return current;
+    }
+
+    void push_front(const value_type& value) {
+        insert_value(value);
+    }
+
+    void push_front(value_type&& value) {
+        insert_value(std::move(value));
+    }
+
+    void pop_front() {
+        if (empty()) {
+            throw std::out_of_range("pop_front() called on empty container.");
+        }
+        erase(begin());
+    }
+
+    void push_back(const value_type& value) {
+        insert_value(value);
+    }
+
+    void push_back(value_type&& value) {
+        insert_value(std::move(value));
+    }
+
+    void pop_back() {
+        if (empty()) {
+            throw std::out_of_range("pop_back() called on empty container.");
+        }
+        erase(--end());
+    }
+
+    void swap(UnrolledContainer& other) noexcept {
+        using std::swap;
+        if (std::allocator_traits<Allocator>::propagate_on_container_swap::value) {
+            swap(node_allocator, other.node_allocator);
+        }
+        swap(sentinel_node, other.sentinel_node);
+        swap(num_elements, other.num_elements);
+        swap(current_max_level, other.current_max_level);
+        swap(rng, other.rng);
+        swap(dist, other.dist);
+    }
+
+    bool contains(const key_type& key) const {
+        return find(key) != end();
+    }
+
+    iterator find(const key_type& key) {
+        const_iterator it = static_cast<const UnrolledContainer&>(*this).find(key);
+        return iterator(const_cast<BaseNode*>(it.current_block), it.offset);
+    }
+
+    const_iterator find(const key_type& key) const {
+        const_iterator it = lower_bound_position(key);
+        if (it != end() && *it == key) {
+            return it;
+        }
+        return end();
+    }
+};
+
+template <typename T, typename Alloc, std::size_t BlockCapacity>
+void swap(UnrolledContainer<T, Alloc, BlockCapacity>& a, UnrolledContainer<T, Alloc, BlockCapacity>& b) noexcept {
+    a.swap(b);
+}
+
+#endif // CONTAINER_UNROLLED_CONTAINER_H
@@ -1,10 +1,23 @@
 #include "gtest/gtest.h" // Подключаем заголовок Google Test
+#define CONTAINER_COUNT_PREV_STEPS // Счетчик container_prev_steps для тестов вставки с подсказкой
 #include "container/container.h" // Подключаем заголовок вашего контейнера
+#include "container/allocators/skip_list_arena.h"
+#include "container/unrolled_container.h"
+#include "container/indexed_container.h"
 #include <string>
 #include <vector>
 #include <stdexcept> // Для проверки исключений
 #include <algorithm> // Для std::equal, std::sort и т.д. (если нужны)
 #include <list> // Для сравнения, если необходимо
+#include <numeric>
+#include <random>
+#include <set>
+#include <limits>
+#include <tuple>
+#include <memory_resource>
+#include <map>
+#include <cstdint>
+#include <array>
 
 // --- 1. Тесты конструкторов и деструктора ---
 TEST(ContainerConstructorsTest, DefaultConstructor) {
@@ -589,4 +602,1721 @@ TEST(ContainerSkipListTest, EraseDuplicates) {
     EXPECT_EQ(c.size(), 4);
     std::vector<int> expected2 = {10, 10, 20, 30};
     EXPECT_TRUE(std::equal(c.begin(), c.end(), expected2.begin()));
-}
\ No newline at end of file
+}
+// Узлы разной высоты: башни выделяются вместе с узлом и должны корректно освобождаться
+TEST(ContainerSkipListTest, ManyElementsAcrossLevels) {
+    Container<int> c;
+    for (int i = 0; i < 2000; ++i) {
+        c.push_back((i * 7919) % 2000);
+    }
+    EXPECT_EQ(c.size(), 2000);
+    int expected = 0;
+    for (const auto& val : c) {
+        EXPECT_EQ(val, expected++);
+    }
+
+    for (int i = 0; i < 2000; i += 2) {
+        c.erase(c.find(i));
+    }
+    EXPECT_EQ(c.size(), 1000);
+    for (int i = 0; i < 2000; ++i) {
+        EXPECT_EQ(c.contains(i), i % 2 == 1);
+    }
+}
+
+// --- 8. Тесты аллокатора ---
+namespace {
+
+struct AllocationStats {
+    std::size_t allocations = 0;
+    std::size_t live_allocations = 0;
+    std::size_t live_bytes = 0;
+};
+
+// Аллокатор, считающий все выделения контейнера (узлы, башни, служебные массивы)
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    AllocationStats* stats;
+
+    explicit CountingAllocator(AllocationStats* s) : stats(s) {}
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& other) noexcept : stats(other.stats) {}
+
+    T* allocate(std::size_t n) {
+        stats->allocations++;
+        stats->live_allocations++;
+        stats->live_bytes += n * sizeof(T);
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        stats->live_allocations--;
+        stats->live_bytes -= n * sizeof(T);
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>& other) const noexcept { return stats == other.stats; }
+
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>& other) const noexcept { return stats != other.stats; }
+};
+
+} // namespace
+
+TEST(ContainerAllocatorTest, AllMemoryGoesThroughAllocator) {
+    AllocationStats stats;
+    {
+        Container<int, CountingAllocator<int>> c{CountingAllocator<int>(&stats)};
+        const std::size_t baseline = stats.allocations; // sentinel + heads
+        for (int i = 0; i < 100; ++i) {
+            c.push_back(i);
+        }
+        EXPECT_EQ(stats.allocations - baseline, 100); // Одна аллокация на элемент
+        EXPECT_EQ(stats.live_allocations, baseline + 100);
+
+        c.erase(c.find(50));
+        EXPECT_EQ(stats.live_allocations, baseline + 99);
+    }
+    EXPECT_EQ(stats.live_allocations, 0);
+    EXPECT_EQ(stats.live_bytes, 0);
+}
+
+TEST(ContainerAllocatorTest, SkipListArenaRecyclesNodes) {
+    SkipListArena<int> arena;
+    {
+        Container<int, SkipListArena<int>> c(arena);
+        for (int i = 0; i < 1000; ++i) {
+            c.push_back(i);
+        }
+        const std::size_t slabs = arena.resource()->slab_count();
+        const std::size_t bytes = arena.resource()->bytes_allocated();
+
+        // Пары erase/insert переиспользуют освобожденные блоки и не растят арену
+        for (int i = 0; i < 10000; ++i) {
+            c.pop_front();
+            c.push_back(1000 + i);
+        }
+        EXPECT_EQ(c.size(), 1000);
+        EXPECT_EQ(c.front(), 10000);
+        EXPECT_EQ(c.back(), 10999);
+        EXPECT_LE(arena.resource()->slab_count(), slabs + 1);
+        EXPECT_LE(arena.resource()->bytes_allocated(), bytes + 1000 * 16 * sizeof(void*));
+    }
+    EXPECT_EQ(arena.resource()->bytes_allocated(), 0);
+}
+
+TEST(ContainerAllocatorTest, SkipListArenaCopyGetsOwnArena) {
+    Container<std::string, SkipListArena<std::string>> c = {"b", "a", "c"};
+    Container<std::string, SkipListArena<std::string>> copy = c;
+    EXPECT_NE(c.get_allocator(), copy.get_allocator());
+    EXPECT_TRUE(std::equal(c.begin(), c.end(), copy.begin()));
+
+    Container<std::string, SkipListArena<std::string>> moved = std::move(copy);
+    EXPECT_EQ(moved.size(), 3);
+    EXPECT_EQ(moved.front(), "a");
+}
+
+TEST(ContainerAllocatorTest, SkipListArenaBulkReleaseOnClear) {
+    Container<int, SkipListArena<int>> c{SkipListArena<int>(4096)};
+    for (int i = 0; i < 5000; ++i) {
+        c.push_back(5000 - i);
+    }
+    EXPECT_GT(c.get_allocator().resource()->slab_count(), 1);
+
+    c.clear();
+    EXPECT_TRUE(c.empty());
+    EXPECT_EQ(c.begin(), c.end());
+
+    for (int i = 0; i < 100; ++i) {
+        c.push_back(i);
+    }
+    EXPECT_EQ(c.size(), 100);
+    EXPECT_EQ(c.front(), 0);
+    EXPECT_EQ(c.back(), 99);
+    EXPECT_TRUE(c.contains(42));
+}
+
+TEST(ContainerAllocatorTest, SkipListArenaBulkReleaseFreesLargeNodes) {
+    // Узел больше slab_size / 4 выделяется мимо слэбов, но сброс арены его тоже освобождает
+    using Large = std::array<std::int64_t, 50>;
+    static_assert(sizeof(Large) > 1024 / 4);
+    Container<Large, SkipListArena<Large>> c{SkipListArena<Large>(1024)};
+    for (int i = 0; i < 200; ++i) {
+        Large value{};
+        value[0] = 200 - i;
+        c.push_back(value);
+    }
+    const auto& arena = *c.get_allocator().resource();
+    EXPECT_GE(arena.large_block_count(), 200);
+
+    c.clear(); // Утечку без учета крупных блоков ловит LSan
+    EXPECT_EQ(arena.large_block_count(), 0);
+    Large value{};
+    value[0] = 7;
+    c.push_back(value);
+    c.erase(c.begin());
+    EXPECT_EQ(arena.large_block_count(), 0);
+    EXPECT_TRUE(c.empty());
+}
+
+TEST(ContainerAllocatorTest, SkipListArenaSharedIsNotReleased) {
+    SkipListArena<int> arena;
+    Container<int, SkipListArena<int>> a(arena);
+    Container<int, SkipListArena<int>> b(arena);
+    for (int i = 0; i < 100; ++i) {
+        a.push_back(i);
+        b.push_back(i);
+    }
+    a.clear(); // Арена общая: узлы b должны остаться живыми
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(b.size(), 100);
+    int expected = 0;
+    for (const auto& val : b) {
+        EXPECT_EQ(val, expected++);
+    }
+}
+
+TEST(ContainerAllocatorTest, ClearKeepsSentinelAndHeads) {
+    AllocationStats stats;
+    Container<int, CountingAllocator<int>> c{CountingAllocator<int>(&stats)};
+    const std::size_t baseline = stats.live_allocations; // sentinel + heads
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 50; ++i) {
+            c.push_back(i);
+        }
+        const std::size_t allocations_before_clear = stats.allocations;
+        c.clear();
+        EXPECT_EQ(stats.allocations, allocations_before_clear); // clear() ничего не выделяет
+        EXPECT_EQ(stats.live_allocations, baseline);
+        EXPECT_TRUE(c.empty());
+        EXPECT_EQ(c.begin(), c.end());
+    }
+}
+
+TEST(ContainerModifiersTest, ClearMovedFromContainer) {
+    Container<int> original = {1, 2, 3};
+    Container<int> moved = std::move(original);
+    original.clear(); // Перемещенный контейнер снова пригоден к использованию
+    original.push_back(7);
+    EXPECT_EQ(original.size(), 1);
+    EXPECT_EQ(original.front(), 7);
+    EXPECT_EQ(moved.size(), 3);
+}
+
+namespace {
+
+// Тип без конструктора по умолчанию: sentinel не должен конструировать T
+struct NoDefault {
+    int key;
+    explicit NoDefault(int k) : key(k) {}
+    bool operator<(const NoDefault& other) const { return key < other.key; }
+    bool operator==(const NoDefault& other) const { return key == other.key; }
+};
+
+} // namespace
+
+TEST(ContainerEdgeCasesTest, NonDefaultConstructibleValues) {
+    Container<NoDefault> c;
+    c.push_back(NoDefault(3));
+    c.push_back(NoDefault(1));
+    c.push_back(NoDefault(2));
+    EXPECT_EQ(c.size(), 3);
+    EXPECT_EQ(c.front().key, 1);
+    EXPECT_EQ(c.back().key, 3);
+    EXPECT_TRUE(c.contains(NoDefault(2)));
+    c.clear();
+    EXPECT_TRUE(c.empty());
+}
+
+TEST(ContainerSkipListTest, EraseNonFirstDuplicate) {
+    Container<int> c;
+    for (int i = 0; i < 200; ++i) {
+        c.push_back(i % 4); // по 50 копий 0, 1, 2, 3
+    }
+    // Удаляем каждую вторую копию единицы, не первую из равных
+    auto it = c.find(1);
+    for (int i = 0; i < 25; ++i) {
+        ++it;
+        it = c.erase(it);
+    }
+    EXPECT_EQ(c.size(), 175);
+    EXPECT_TRUE(std::is_sorted(c.begin(), c.end()));
+    EXPECT_EQ(std::count(c.begin(), c.end(), 1), 25);
+
+    // Skip List должен остаться согласованным с DLL
+    while (!c.empty()) {
+        c.erase(c.find(c.back()));
+    }
+    EXPECT_TRUE(c.empty());
+}
+
+TEST(ContainerLayoutTest, CompactNodeFitsCacheLine) {
+    using Storage = NodeStorage<std::int64_t>;
+    EXPECT_LE(sizeof(NodeBase<>), 16);
+    EXPECT_LE(Storage::units<Node<std::int64_t>>(0) * sizeof(Storage), 32);
+    EXPECT_LE(Storage::units<Node<std::int64_t>>(3) * sizeof(Storage), 64);
+}
+
+// --- 9. Односвязный режим ---
+TEST(ForwardContainerTest, LayoutWithoutPrev) {
+    using Storage = NodeStorage<std::int64_t, false>;
+    using ForwardNode = Node<std::int64_t, false>;
+    EXPECT_LT(sizeof(NodeBase<false>), sizeof(NodeBase<true>));
+    EXPECT_LE(Storage::units<ForwardNode>(0) * sizeof(Storage), 24);
+    static_assert(std::is_same_v<ForwardContainer<int>::iterator::iterator_category, std::forward_iterator_tag>);
+    static_assert(std::is_same_v<Container<int>::iterator::iterator_category, std::bidirectional_iterator_tag>);
+}
+
+TEST(ForwardContainerTest, BasicOperations) {
+    ForwardContainer<int> c = {30, 10, 20};
+    EXPECT_EQ(c.size(), 3);
+    EXPECT_EQ(c.front(), 10);
+    EXPECT_EQ(c.back(), 30);
+    std::vector<int> expected = {10, 20, 30};
+    EXPECT_TRUE(std::equal(c.begin(), c.end(), expected.begin(), expected.end()));
+
+    c.erase(c.find(20));
+    c.pop_back();
+    EXPECT_EQ(c.size(), 1);
+    EXPECT_EQ(c.back(), 10);
+    c.pop_front();
+    EXPECT_TRUE(c.empty());
+    EXPECT_THROW(c.pop_back(), std::out_of_range);
+}
+
+TEST(ForwardContainerTest, ManyElements) {
+    ForwardContainer<int> c;
+    for (int i = 0; i < 1000; ++i) {
+        c.push_back((i * 7919) % 1000);
+    }
+    EXPECT_TRUE(std::is_sorted(c.begin(), c.end()));
+    EXPECT_EQ(c.back(), 999);
+    for (int i = 0; i < 500; ++i) {
+        c.pop_back();
+    }
+    EXPECT_EQ(c.size(), 500);
+    EXPECT_EQ(c.back(), 499);
+    EXPECT_TRUE(c.contains(250));
+    EXPECT_FALSE(c.contains(750));
+
+    ForwardContainer<int> copy = c;
+    EXPECT_TRUE(std::equal(c.begin(), c.end(), copy.begin(), copy.end()));
+}
+
+// --- 10. Hot/cold split ---
+namespace {
+
+struct Record {
+    std::int64_t timestamp;
+    char payload[200];
+};
+
+struct TimestampOf {
+    std::int64_t operator()(const Record& r) const noexcept { return r.timestamp; }
+};
+
+Record make_record(std::int64_t ts) {
+    Record r{};
+    r.timestamp = ts;
+    r.payload[0] = static_cast<char>('a' + ts % 26);
+    return r;
+}
+
+} // namespace
+
+TEST(SplitKeyContainerTest, NodeKeepsOnlyKey) {
+    using Policy = SplitKey<Record, TimestampOf>;
+    using SplitNode = Node<Record, true, Policy>;
+    EXPECT_LT(sizeof(SplitNode), sizeof(Record));
+    EXPECT_LE(sizeof(SplitNode), 32);
+}
+
+namespace {
+
+// Ключ с деструктором, считающий живые копии.
+struct LiveKey {
+    static int alive;
+    std::int64_t value;
+
+    LiveKey(std::int64_t v) : value(v) { ++alive; }
+    LiveKey(const LiveKey& other) : value(other.value) { ++alive; }
+    ~LiveKey() { --alive; }
+    LiveKey& operator=(const LiveKey&) = default;
+
+    bool operator<(const LiveKey& other) const { return value < other.value; }
+};
+
+int LiveKey::alive = 0;
+
+struct LiveKeyOf {
+    LiveKey operator()(const Record& r) const { return LiveKey(r.timestamp); }
+};
+
+} // namespace
+
+TEST(SplitKeyContainerTest, ArenaClearDestroysNonTrivialKeys) {
+    // Record тривиально уничтожается, а ключ в узле - нет: обходить узлы все равно нужно
+    {
+        SplitKeyContainer<Record, LiveKeyOf, SkipListArena<Record>> c{SkipListArena<Record>(4096)};
+        for (std::int64_t i = 0; i < 1000; ++i) {
+            c.push_back(make_record(i));
+        }
+        EXPECT_EQ(LiveKey::alive, 1000);
+        c.clear();
+        EXPECT_EQ(LiveKey::alive, 0);
+        c.push_back(make_record(7));
+        EXPECT_TRUE(c.contains(LiveKey(7)));
+    }
+    EXPECT_EQ(LiveKey::alive, 0);
+}
+
+TEST(SplitKeyContainerTest, FindByKey) {
+    SplitKeyContainer<Record, TimestampOf> c;
+    for (std::int64_t ts = 100; ts > 0; --ts) {
+        c.push_back(make_record(ts * 10));
+    }
+    EXPECT_EQ(c.size(), 100);
+    EXPECT_EQ(c.front().timestamp, 10);
+    EXPECT_EQ(c.back().timestamp, 1000);
+
+    auto it = c.find(500);
+    ASSERT_NE(it, c.end());
+    EXPECT_EQ(it->timestamp, 500);
+    EXPECT_EQ(it->payload[0], static_cast<char>('a' + 500 % 26));
+    EXPECT_FALSE(c.contains(505));
+
+    c.erase(it);
+    EXPECT_FALSE(c.contains(500));
+    EXPECT_EQ(c.size(), 99);
+
+    std::int64_t previous = 0;
+    for (const auto& record : c) {
+        EXPECT_LT(previous, record.timestamp);
+        previous = record.timestamp;
+    }
+}
+
+TEST(SplitKeyContainerTest, PayloadsGoThroughAllocator) {
+    AllocationStats stats;
+    {
+        SplitKeyContainer<Record, TimestampOf, CountingAllocator<Record>> c{CountingAllocator<Record>(&stats)};
+        const std::size_t baseline = stats.live_allocations;
+        c.push_back(make_record(2));
+        c.push_back(make_record(1));
+        EXPECT_EQ(stats.live_allocations, baseline + 4); // узел + запись на элемент
+
+        SplitKeyContainer<Record, TimestampOf, CountingAllocator<Record>> copy = c;
+        EXPECT_EQ(copy.front().timestamp, 1);
+        c.clear();
+        EXPECT_EQ(stats.live_allocations, baseline + copy.size() * 2 + baseline);
+    }
+    EXPECT_EQ(stats.live_allocations, 0);
+}
+
+namespace {
+
+// Копирование и перемещение бросают, когда счетчик операций доходит до нуля.
+struct FragileValue {
+    static int operations_left;
+    int value;
+
+    FragileValue(int v) : value(v) {}
+    FragileValue(const FragileValue& other) : value(other.value) { count_operation(); }
+    FragileValue(FragileValue&& other) noexcept(false) : value(other.value) { count_operation(); }
+    FragileValue& operator=(const FragileValue&) = default;
+
+    static void count_operation() {
+        if (operations_left-- == 0) {
+            throw std::runtime_error("FragileValue operation failed");
+        }
+    }
+
+    bool operator<(const FragileValue& other) const { return value < other.value; }
+    bool operator==(const FragileValue& other) const { return value == other.value; }
+};
+
+int FragileValue::operations_left = std::numeric_limits<int>::max();
+
+} // namespace
+
+// --- Развернутый Skip List ---
+TEST(UnrolledContainerTest, BasicOperations) {
+    UnrolledContainer<int, std::allocator<int>, 4> c = {5, 1, 4, 2, 3};
+    EXPECT_EQ(c.size(), 5);
+    EXPECT_EQ(c.front(), 1);
+    EXPECT_EQ(c.back(), 5);
+    EXPECT_TRUE(c.contains(3));
+    EXPECT_FALSE(c.contains(6));
+
+    std::vector<int> forward(c.begin(), c.end());
+    EXPECT_EQ(forward, std::vector<int>({1, 2, 3, 4, 5}));
+
+    std::vector<int> backward;
+    for (auto it = c.end(); it != c.begin();) {
+        backward.push_back(*--it);
+    }
+    EXPECT_EQ(backward, std::vector<int>({5, 4, 3, 2, 1}));
+
+    auto it = c.erase(c.find(3));
+    ASSERT_NE(it, c.end());
+    EXPECT_EQ(*it, 4);
+    c.pop_front();
+    c.pop_back();
+    EXPECT_EQ(std::vector<int>(c.begin(), c.end()), std::vector<int>({2, 4}));
+
+    c.clear();
+    EXPECT_TRUE(c.empty());
+    EXPECT_EQ(c.begin(), c.end());
+    EXPECT_THROW(c.front(), std::out_of_range);
+}
+
+TEST(UnrolledContainerTest, ManyElementsWithSplitsAndDuplicates) {
+    UnrolledContainer<int, std::allocator<int>, 8> c;
+    std::vector<int> reference;
+    for (int i = 0; i < 2000; ++i) {
+        int value = (i * 7919) % 503; // Вперемешку и с повторами
+        c.push_back(value);
+        reference.push_back(value);
+    }
+    std::sort(reference.begin(), reference.end());
+    EXPECT_EQ(c.size(), reference.size());
+    EXPECT_TRUE(std::equal(c.begin(), c.end(), reference.begin(), reference.end()));
+
+    for (int value = 0; value < 503; value += 2) {
+        while (c.contains(value)) {
+            c.erase(c.find(value));
+            reference.erase(std::find(reference.begin(), reference.end(), value));
+        }
+    }
+    EXPECT_EQ(c.size(), reference.size());
+    EXPECT_TRUE(std::equal(c.begin(), c.end(), reference.begin(), reference.end()));
+    for (int value = 1; value < 503; value += 2) {
+        EXPECT_TRUE(c.contains(value));
+    }
+
+    c.erase(c.begin(), c.end());
+    EXPECT_TRUE(c.empty());
+    c.push_back(42);
+    EXPECT_EQ(c.front(), 42);
+}
+
+TEST(UnrolledContainerTest, CopyMoveAndAllocator) {
+    AllocationStats stats;
+    {
+        using Unrolled = UnrolledContainer<std::string, CountingAllocator<std::string>, 16>;
+        Unrolled c{CountingAllocator<std::string>(&stats)};
+        const std::size_t baseline = stats.live_allocations;
+        for (int i = 0; i < 64; ++i) {
+            c.push_back("value " + std::to_string(1000 + i));
+        }
+        // 64 элемента по порядку заполняют блоки целиком
+        EXPECT_EQ(stats.live_allocations, baseline + 4);
+
+        Unrolled copy = c;
+        EXPECT_TRUE(std::equal(c.begin(), c.end(), copy.begin(), copy.end()));
+
+        Unrolled moved = std::move(copy);
+        EXPECT_EQ(moved.size(), 64);
+        copy.clear();
+        EXPECT_TRUE(copy.empty());
+        copy.push_back("again");
+        EXPECT_EQ(copy.front(), "again");
+
+        moved = c;
+        EXPECT_EQ(moved.back(), "value 1063");
+    }
+    EXPECT_EQ(stats.live_allocations, 0);
+}
+
+TEST(UnrolledContainerTest, InsertOwnElementIntoFullBlock) {
+    UnrolledContainer<std::string, std::allocator<std::string>, 4> c;
+    for (char letter = 'a'; letter < 'i'; ++letter) {
+        c.push_back(std::string(32, letter)); // Блоки [a..d] и [e..h], оба полные
+    }
+    // Копия 'd' из верхней половины делимого блока
+    auto it = c.insert(c.cend(), *c.find(std::string(32, 'd')));
+    EXPECT_EQ(*it, std::string(32, 'd'));
+    EXPECT_EQ(c.size(), 9);
+    EXPECT_EQ(std::distance(c.begin(), c.end()), 9);
+    EXPECT_EQ(*std::next(it), std::string(32, 'd'));
+    EXPECT_TRUE(std::is_sorted(c.begin(), c.end()));
+}
+
+TEST(UnrolledContainerTest, ThrowingInsertLeavesNoEmptyBlocks) {
+    UnrolledContainer<FragileValue, std::allocator<FragileValue>, 4> c;
+    FragileValue::operations_left = 0;
+    EXPECT_THROW(c.push_back(FragileValue(0)), std::runtime_error); // Первый блок
+    FragileValue::operations_left = std::numeric_limits<int>::max();
+    EXPECT_TRUE(c.empty());
+    EXPECT_EQ(c.begin(), c.end());
+
+    for (int i = 0; i < 8; ++i) {
+        c.push_back(FragileValue(2 * i)); // Блоки [0..6] и [8..14]
+    }
+    FragileValue::operations_left = 0;
+    EXPECT_THROW(c.push_back(FragileValue(100)), std::runtime_error); // Новый последний блок
+    FragileValue::operations_left = 1;
+    EXPECT_THROW(c.push_back(FragileValue(5)), std::runtime_error);   // Копия при делении блока
+    FragileValue::operations_left = std::numeric_limits<int>::max();
+
+    EXPECT_EQ(c.size(), 8);
+    int expected = 0;
+    for (const FragileValue& value : c) {
+        EXPECT_EQ(value.value, expected);
+        expected += 2;
+    }
+    EXPECT_EQ(c.back().value, 14);
+    c.push_back(FragileValue(5));
+    c.push_back(FragileValue(100));
+    EXPECT_TRUE(c.contains(FragileValue(5)));
+    c.erase(c.find(FragileValue(100)));
+    EXPECT_EQ(c.back().value, 14);
+    EXPECT_EQ(c.size(), 9);
+}
+
+// --- Сжатые 32-битные связи ---
+TEST(IndexedContainerTest, SlotLayout) {
+    EXPECT_EQ(sizeof(IndexedSlot<std::int64_t>), 24);
+    EXPECT_EQ(sizeof(IndexedSlot<std::int32_t>), 20);
+}
+
+TEST(IndexedContainerTest, BasicOperations) {
+    IndexedContainer<int> c = {5, 1, 4, 2, 3};
+    EXPECT_EQ(c.size(), 5);
+    EXPECT_EQ(c.front(), 1);
+    EXPECT_EQ(c.back(), 5);
+    EXPECT_EQ(std::vector<int>(c.begin(), c.end()), std::vector<int>({1, 2, 3, 4, 5}));
+
+    auto it = c.erase(c.find(3));
+    ASSERT_NE(it, c.end());
+    EXPECT_EQ(*it, 4);
+    EXPECT_EQ(*--it, 2);
+    c.pop_front();
+    c.pop_back();
+    EXPECT_EQ(std::vector<int>(c.begin(), c.end()), std::vector<int>({2, 4}));
+    EXPECT_FALSE(c.contains(3));
+
+    c.clear();
+    EXPECT_TRUE(c.empty());
+    EXPECT_EQ(c.begin(), c.end());
+    EXPECT_THROW(c.back(), std::out_of_range);
+}
+
+TEST(IndexedContainerTest, IteratorsSurviveGrowthAndSlotsAreReused) {
+    IndexedContainer<std::string> c;
+    c.push_back("m");
+    auto it = c.begin();
+    for (int i = 0; i < 1000; ++i) {
+        c.push_back(std::to_string(i)); // Массив слотов несколько раз переезжает
+    }
+    EXPECT_EQ(*it, "m");
+
+    std::vector<std::string> reference(c.begin(), c.end());
+    EXPECT_TRUE(std::is_sorted(reference.begin(), reference.end()));
+
+    for (int i = 0; i < 1000; i += 2) {
+        c.erase(c.find(std::to_string(i)));
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        c.push_back(std::to_string(i) + "x");
+    }
+    EXPECT_EQ(c.size(), 1001);
+    reference.assign(c.begin(), c.end());
+    EXPECT_TRUE(std::is_sorted(reference.begin(), reference.end()));
+    EXPECT_TRUE(c.contains("998x"));
+    EXPECT_FALSE(c.contains("998"));
+}
+
+TEST(IndexedContainerTest, SwapAndMoveInvalidateIterators) {
+    // Итератор привязан к объекту контейнера, а не к массиву слотов: после swap
+    // элемент 2 лежит в b, но старый итератор к нему не относится. У Container
+    // итераторы узлов переезжают вместе с узлами.
+    IndexedContainer<int> a = {1, 2, 3};
+    IndexedContainer<int> b = {10, 20};
+    const auto it = a.find(2);
+    const auto a_end = a.end();
+    a.swap(b);
+    EXPECT_NE(it, b.find(2));
+    EXPECT_EQ(a_end, a.end());
+    EXPECT_NE(a_end, b.end());
+
+    const auto b_it = b.find(3);
+    IndexedContainer<int> moved = std::move(b);
+    EXPECT_NE(b_it, moved.find(3));
+    EXPECT_EQ(*moved.find(3), 3);
+
+    Container<int> x = {1, 2, 3};
+    Container<int> y;
+    const auto node_it = x.find(2);
+    x.swap(y);
+    EXPECT_EQ(node_it, y.find(2));
+    EXPECT_EQ(*node_it, 2);
+}
+
+TEST(IndexedContainerTest, CopyMoveAndAllocator) {
+    AllocationStats stats;
+    {
+        using Indexed = IndexedContainer<int, CountingAllocator<int>>;
+        Indexed c{CountingAllocator<int>(&stats)};
+        for (int i = 0; i < 100; ++i) {
+            c.push_back(100 - i);
+        }
+        EXPECT_EQ(stats.live_allocations, 2); // Слоты и башни
+
+        Indexed copy = c;
+        EXPECT_TRUE(std::equal(c.begin(), c.end(), copy.begin(), copy.end()));
+
+        Indexed moved = std::move(copy);
+        EXPECT_EQ(moved.size(), 100);
+        EXPECT_EQ(moved.front(), 1);
+        copy.clear();
+        copy.push_back(7);
+        EXPECT_EQ(copy.back(), 7);
+
+        moved = copy;
+        EXPECT_EQ(moved.size(), 1);
+    }
+    EXPECT_EQ(stats.live_allocations, 0);
+}
+
+TEST(IndexedContainerTest, InsertOwnElementWhileGrowing) {
+    IndexedContainer<std::string> c;
+    for (int i = 0; i < 15; ++i) {
+        c.push_back(std::string(32, static_cast<char>('a' + i))); // 15 элементов + sentinel - массив полон
+    }
+    c.push_back(c.back()); // Источник лежит в переезжающем массиве
+    c.insert(c.cend(), *c.begin());
+    EXPECT_EQ(c.size(), 17);
+    EXPECT_EQ(c.front(), std::string(32, 'a'));
+    EXPECT_EQ(*std::next(c.begin()), std::string(32, 'a'));
+    EXPECT_EQ(c.back(), std::string(32, 'a' + 14));
+    EXPECT_EQ(*std::prev(c.end(), 2), std::string(32, 'a' + 14));
+}
+
+TEST(IndexedContainerTest, ThrowingRelocationKeepsContents) {
+    IndexedContainer<FragileValue> c;
+    for (int i = 0; i < 15; ++i) {
+        c.push_back(FragileValue(i));
+    }
+    // Новое значение копируется, затем бросает копия одного из старых
+    FragileValue::operations_left = 5;
+    EXPECT_THROW(c.push_back(FragileValue(100)), std::runtime_error);
+    FragileValue::operations_left = std::numeric_limits<int>::max();
+
+    EXPECT_EQ(c.size(), 15);
+    int expected = 0;
+    for (const FragileValue& value : c) {
+        EXPECT_EQ(value.value, expected++);
+    }
+    c.push_back(FragileValue(100));
+    EXPECT_EQ(c.size(), 16);
+    EXPECT_EQ(c.back().value, 100);
+    EXPECT_TRUE(c.contains(FragileValue(7)));
+}
+
+// --- Горячая арена для высоких башен ---
+TEST(ContainerHotTowerTest, TallNodesLiveInHotArena) {
+    AllocationStats stats;
+    {
+        Container<int, CountingAllocator<int>> c{CountingAllocator<int>(&stats)};
+        EXPECT_EQ(c.hot_tower_level(), 16); // По умолчанию выключена
+        c.set_hot_tower_level(1);
+        EXPECT_EQ(c.hot_tower_level(), 1);
+
+        for (int i = 0; i < 2000; ++i) {
+            c.push_back((i * 7919) % 2000);
+        }
+        // Примерно половина узлов выше нулевого уровня и берется из слэбов арены
+        EXPECT_LT(stats.live_allocations, 1500);
+
+        for (int i = 0; i < 2000; i += 3) {
+            c.erase(c.find(i));
+        }
+        for (int i = 0; i < 2000; i += 3) {
+            c.push_back(i);
+        }
+        std::vector<int> expected(2000);
+        std::iota(expected.begin(), expected.end(), 0);
+        EXPECT_TRUE(std::equal(c.begin(), c.end(), expected.begin(), expected.end()));
+
+        EXPECT_THROW(c.set_hot_tower_level(2), std::logic_error);
+        EXPECT_THROW(c.set_hot_tower_level(0), std::invalid_argument);
+
+        Container<int, CountingAllocator<int>> copy = c;
+        EXPECT_EQ(copy.hot_tower_level(), 1);
+        Container<int, CountingAllocator<int>> moved = std::move(copy);
+        EXPECT_TRUE(std::equal(moved.begin(), moved.end(), expected.begin(), expected.end()));
+        swap(moved, c);
+        moved.clear();
+        moved.set_hot_tower_level(16);
+        moved.push_back(1);
+        EXPECT_EQ(moved.front(), 1);
+    }
+    EXPECT_EQ(stats.live_allocations, 0);
+}
+
+TEST(ContainerHotTowerTest, WorksWithSkipListArena) {
+    Container<std::int64_t, SkipListArena<std::int64_t>> c;
+    c.set_hot_tower_level(2);
+    for (std::int64_t i = 0; i < 5000; ++i) {
+        c.push_back(i);
+    }
+    c.clear(); // Массовое освобождение вместе со слэбами горячей арены
+    EXPECT_TRUE(c.empty());
+    for (std::int64_t i = 0; i < 5000; ++i) {
+        c.push_front(5000 - i);
+    }
+    EXPECT_EQ(c.size(), 5000);
+    EXPECT_TRUE(c.contains(2500));
+}
+
+TEST(SkipListArenaTest, HugePageBacking) {
+    Container<std::int64_t, SkipListArena<std::int64_t>> c{make_huge_page_arena<std::int64_t>()};
+    const auto& resource = *c.get_allocator().resource();
+    EXPECT_EQ(resource.page_backing(), PageBacking::HugePages);
+    EXPECT_EQ(resource.slab_size() % HugePageMemory::HUGE_PAGE_SIZE, 0);
+
+    for (std::int64_t i = 0; i < 100000; ++i) {
+        c.push_back((i * 7919) % 100000);
+    }
+    EXPECT_GE(resource.slab_count(), 1);
+    c.defragment(); // Регион больше четверти слэба тоже берется у HugePageMemory
+    EXPECT_EQ(c.size(), 100000);
+    EXPECT_EQ(c.front(), 0);
+    EXPECT_EQ(c.back(), 99999);
+    EXPECT_TRUE(c.contains(4242));
+
+    auto copy = c; // Копия получает свою арену с теми же страницами
+    EXPECT_EQ(copy.get_allocator().resource()->page_backing(), PageBacking::HugePages);
+    EXPECT_NE(copy.get_allocator(), c.get_allocator());
+    c.clear();
+    EXPECT_TRUE(c.empty());
+    ASSERT_EQ(copy.size(), 100000);
+    std::int64_t expected = 0;
+    for (std::int64_t value : copy) {
+        ASSERT_EQ(value, expected++);
+    }
+}
+
+// --- Толстые связи с копией ключа следующего узла ---
+TEST(CachedLinkContainerTest, LinksCarryKeys) {
+    using CachedNode = Node<std::int64_t, true, CachedLinkKey<std::int64_t>>;
+    EXPECT_EQ(CachedNode::Base::tower_bytes<CachedNode>(0), 16);
+    EXPECT_EQ(CachedNode::Base::tower_bytes<CachedNode>(3), 64);
+}
+
+TEST(CachedLinkContainerTest, MatchesSortedReference) {
+    CachedLinkContainer<std::int64_t> c;
+    std::multiset<std::int64_t> reference;
+    std::mt19937 gen(123);
+    for (int step = 0; step < 5000; ++step) {
+        const std::int64_t value = gen() % 700; // С повторами
+        if (step % 3 == 2 && c.contains(value)) {
+            c.erase(c.find(value));
+            reference.erase(reference.find(value));
+        } else {
+            c.push_back(value);
+            reference.insert(value);
+        }
+    }
+    EXPECT_EQ(c.size(), reference.size());
+    EXPECT_TRUE(std::equal(c.begin(), c.end(), reference.begin(), reference.end()));
+    for (std::int64_t value = 0; value < 700; ++value) {
+        EXPECT_EQ(c.contains(value), reference.count(value) > 0);
+    }
+
+    c.pop_front();
+    c.pop_back();
+    reference.erase(reference.begin());
+    reference.erase(std::prev(reference.end()));
+    EXPECT_TRUE(std::equal(c.begin(), c.end(), reference.begin(), reference.end()));
+    c.clear();
+    c.push_back(-1);
+    EXPECT_TRUE(c.contains(-1));
+}
+
+// --- Префиксы строк в узлах ---
+TEST(StringPrefixKeyTest, PrefixOrderMatchesStringOrder) {
+    const std::vector<std::string> samples = {
+        "", std::string("\0", 1), "a", std::string("a\0", 2), "ab", "abcdefgh", "abcdefgh0",
+        "abcdefghz", "abcdefgi", "b", "\x7f", "\x80", "\xff\xff", "https://example.com/a",
+        "https://example.com/b", "https://example.org/"};
+    for (const auto& a : samples) {
+        for (const auto& b : samples) {
+            const auto pa = StringPrefixKey::prefix_of(a);
+            const auto pb = StringPrefixKey::prefix_of(b);
+            if (pa != pb) {
+                EXPECT_EQ(pa < pb, a < b) << a << " vs " << b;
+            }
+        }
+    }
+}
+
+TEST(StringPrefixKeyTest, StringContainerUsesPrefixes) {
+    using StringNode = Node<std::string>;
+    static_assert(std::is_same_v<decltype(StringNode::key), std::uint64_t>);
+
+    Container<std::string> c;
+    const std::vector<std::string> urls = {
+        "https://example.com/b", "https://example.com/a", "https://example.com/a",
+        "/usr/lib", "/usr/local/lib", "", "\xff", std::string("https\0", 6)};
+    for (const auto& url : urls) {
+        c.push_back(url);
+    }
+    std::vector<std::string> sorted = urls;
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_TRUE(std::equal(c.begin(), c.end(), sorted.begin(), sorted.end()));
+
+    EXPECT_TRUE(c.contains("https://example.com/a"));
+    EXPECT_TRUE(c.contains(std::string("https\0", 6)));
+    EXPECT_FALSE(c.contains("https"));
+    EXPECT_FALSE(c.contains("https://example.com/c"));
+
+    c.erase(c.find("https://example.com/a"));
+    EXPECT_TRUE(c.contains("https://example.com/a"));
+    c.erase(c.find("https://example.com/a"));
+    EXPECT_FALSE(c.contains("https://example.com/a"));
+    EXPECT_EQ(c.size(), urls.size() - 2);
+}
+
+// --- reserve() и shrink_to_fit() ---
+TEST(ContainerReserveTest, ReservedInsertsDoNotAllocate) {
+    AllocationStats stats;
+    {
+        Container<int, CountingAllocator<int>> c{CountingAllocator<int>(&stats)};
+        c.reserve(1000);
+        EXPECT_EQ(c.capacity(), 1000);
+        const std::size_t allocations = stats.allocations;
+        const std::size_t live = stats.live_allocations;
+
+        for (int i = 0; i < 1000; ++i) {
+            c.push_back((i * 7919) % 1000);
+        }
+        EXPECT_EQ(stats.allocations, allocations); // Все узлы взяты из пула
+        EXPECT_EQ(stats.live_allocations, live);
+        EXPECT_EQ(c.capacity(), 1000);
+        std::vector<int> expected(1000);
+        std::iota(expected.begin(), expected.end(), 0);
+        EXPECT_TRUE(std::equal(c.begin(), c.end(), expected.begin(), expected.end()));
+
+        c.push_back(1000); // Сверх резерва - обычное выделение
+        EXPECT_EQ(stats.allocations, allocations + 1);
+
+        c.reserve(10); // Меньше size() - ничего не делает
+        EXPECT_EQ(c.capacity(), c.size());
+    }
+    EXPECT_EQ(stats.live_allocations, 0);
+}
+
+TEST(ContainerReserveTest, ShrinkToFitReturnsPooledBlocks) {
+    AllocationStats stats;
+    {
+        Container<std::string, CountingAllocator<std::string>> c{CountingAllocator<std::string>(&stats)};
+        const std::size_t baseline = stats.live_allocations;
+        c.push_back("a");
+        c.reserve(100);
+        EXPECT_EQ(stats.live_allocations, baseline + 100);
+
+        Container<std::string, CountingAllocator<std::string>> moved = std::move(c);
+        EXPECT_EQ(moved.capacity(), 100);
+        moved.push_back("b");
+        EXPECT_EQ(stats.live_allocations, baseline + 100);
+
+        moved.shrink_to_fit();
+        EXPECT_EQ(moved.capacity(), 2);
+        EXPECT_EQ(stats.live_allocations, baseline + 2);
+
+        moved.clear();
+        moved.reserve(50); // Пул переживает смену порога горячей арены только через drain
+        moved.set_hot_tower_level(1);
+        EXPECT_EQ(moved.capacity(), 0);
+        moved.reserve(50);
+        moved.push_back("c");
+        EXPECT_EQ(moved.front(), "c");
+    }
+    EXPECT_EQ(stats.live_allocations, 0);
+}
+
+// --- Переиспользование удаленных узлов ---
+TEST(ContainerNodeCacheTest, SlidingWindowRarelyAllocates) {
+    AllocationStats stats;
+    {
+        Container<int, CountingAllocator<int>> c{CountingAllocator<int>(&stats)};
+        EXPECT_EQ(c.node_cache_limit(), 0);
+        c.set_node_cache_limit(64);
+
+        for (int i = 0; i < 200; ++i) {
+            c.push_back(i);
+        }
+        // Прогрев: кэш заполняется удаленными узлами
+        for (int i = 200; i < 2200; ++i) {
+            c.pop_front();
+            c.push_back(i);
+        }
+        const std::size_t allocations = stats.allocations;
+        for (int i = 2200; i < 4200; ++i) {
+            c.pop_front();
+            c.push_back(i);
+        }
+        // Высоту дает генератор, поэтому мимо кэша проходят только редкие высокие узлы
+        EXPECT_LT(stats.allocations - allocations, 2000 / 10);
+        EXPECT_EQ(c.size(), 200);
+        EXPECT_EQ(c.front(), 4000);
+        EXPECT_EQ(c.back(), 4199);
+
+        c.clear(); // Узлы сверх лимита уходят аллокатору
+        EXPECT_LE(stats.live_allocations, 64 + 2 + 64);
+        c.set_node_cache_limit(0);
+        EXPECT_EQ(c.capacity(), 0);
+        const std::size_t live = stats.live_allocations;
+        c.push_back(1);
+        c.erase(c.begin());
+        EXPECT_EQ(stats.live_allocations, live);
+    }
+    EXPECT_EQ(stats.live_allocations, 0);
+}
+
+TEST(ContainerNodeCacheTest, CacheAndReserveShareThePool) {
+    AllocationStats stats;
+    {
+        Container<std::string, CountingAllocator<std::string>> c{CountingAllocator<std::string>(&stats)};
+        const std::size_t baseline = stats.live_allocations;
+        c.set_node_cache_limit(10);
+        c.reserve(5);
+        for (int i = 0; i < 20; ++i) {
+            c.push_back(std::to_string(i));
+        }
+        for (int i = 0; i < 20; ++i) {
+            c.pop_back();
+        }
+        EXPECT_EQ(stats.live_allocations, baseline + 10);
+        c.set_node_cache_limit(3);
+        EXPECT_EQ(stats.live_allocations, baseline + 3);
+
+        Container<std::string, CountingAllocator<std::string>> copy = c;
+        EXPECT_EQ(copy.node_cache_limit(), 3);
+        c.shrink_to_fit();
+        EXPECT_EQ(stats.live_allocations, baseline * 2);
+    }
+    EXPECT_EQ(stats.live_allocations, 0);
+}
+
+TEST(ContainerDefragmentTest, KeepsOrderAndFreesOldNodes) {
+    AllocationStats stats;
+    {
+        Container<std::string, CountingAllocator<std::string>> c{CountingAllocator<std::string>(&stats)};
+        std::set<std::string> reference;
+        std::mt19937 gen(18);
+        for (int i = 0; i < 2000; ++i) {
+            const std::string key = std::to_string(gen() % 1000);
+            if (gen() % 3 == 0 && c.contains(key)) {
+                c.erase(c.find(key));
+                reference.erase(key);
+            } else if (!c.contains(key)) {
+                c.insert(c.end(), key);
+                reference.insert(key);
+            }
+        }
+        const std::size_t baseline = stats.live_allocations - c.size();
+
+        c.defragment();
+        EXPECT_EQ(stats.live_allocations, baseline + 1); // Один регион вместо узлов
+        ASSERT_EQ(c.size(), reference.size());
+        EXPECT_TRUE(std::equal(c.begin(), c.end(), reference.begin()));
+        EXPECT_EQ(*std::prev(c.end()), *reference.rbegin());
+        EXPECT_EQ(*std::prev(c.end(), 2), *std::next(reference.rbegin()));
+        for (const auto& key : reference) {
+            ASSERT_TRUE(c.contains(key));
+        }
+
+        // Вставки после defragment() идут в обычные узлы, удаления не трогают регион
+        c.insert(c.end(), "x");
+        c.erase(c.find(*reference.begin()));
+        reference.erase(reference.begin());
+        reference.insert("x");
+        EXPECT_TRUE(std::equal(c.begin(), c.end(), reference.begin()));
+        EXPECT_EQ(stats.live_allocations, baseline + 2);
+
+        c.defragment(); // Прежний регион освобождается вместе с последним узлом в нем
+        EXPECT_EQ(stats.live_allocations, baseline + 1);
+        EXPECT_TRUE(std::equal(c.begin(), c.end(), reference.begin()));
+
+        while (!c.empty()) {
+            c.pop_front();
+        }
+        EXPECT_EQ(stats.live_allocations, baseline);
+        c.defragment(); // Пустой контейнер не меняется
+        EXPECT_EQ(stats.live_allocations, baseline);
+    }
+    EXPECT_EQ(stats.live_allocations, 0);
+}
+
+TEST(ContainerDefragmentTest, OtherNodeLayouts) {
+    CachedLinkContainer<int> cached;
+    ForwardContainer<int> forward;
+    SplitKeyContainer<Record, TimestampOf> split;
+    for (int i = 0; i < 500; ++i) {
+        const int key = (i * 37) % 500;
+        cached.insert(cached.end(), key);
+        forward.insert(forward.end(), key);
+        split.push_back(make_record(key));
+    }
+    for (int i = 0; i < 500; i += 3) {
+        cached.erase(cached.find(i));
+        forward.erase(forward.find(i));
+        split.erase(split.find(i));
+    }
+    cached.defragment();
+    forward.defragment();
+    split.defragment();
+
+    std::vector<int> expected;
+    for (int i = 0; i < 500; ++i) {
+        if (i % 3 != 0) {
+            expected.push_back(i);
+        }
+    }
+    EXPECT_TRUE(std::equal(cached.begin(), cached.end(), expected.begin(), expected.end()));
+    EXPECT_TRUE(std::equal(forward.begin(), forward.end(), expected.begin(), expected.end()));
+    ASSERT_EQ(split.size(), expected.size());
+    auto record = split.begin();
+    for (int key : expected) {
+        EXPECT_EQ(record->timestamp, key);
+        EXPECT_EQ(record->payload[0], static_cast<char>('a' + key % 26));
+        ++record;
+    }
+    for (int key : expected) {
+        ASSERT_NE(cached.find(key), cached.end());
+        ASSERT_NE(forward.find(key), forward.end());
+        ASSERT_NE(split.find(key), split.end());
+    }
+    EXPECT_EQ(cached.find(3), cached.end());
+}
+
+TEST(PmrContainerTest, MonotonicBufferMakesNoHeapCalls) {
+    alignas(std::max_align_t) unsigned char buffer[64 * 1024];
+    std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    // Любое обращение к ресурсу по умолчанию бросит bad_alloc
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    {
+        pmr::Container<int> c{std::pmr::polymorphic_allocator<int>(&resource)};
+        for (int i = 0; i < 200; ++i) {
+            c.insert(c.end(), (i * 31) % 200);
+        }
+        c.erase(c.find(100));
+        c.defragment();
+        EXPECT_EQ(c.size(), 199);
+        EXPECT_EQ(c.front(), 0);
+        EXPECT_FALSE(c.contains(100));
+        EXPECT_EQ(c.get_allocator().resource(), &resource);
+
+        // Исходные строки живут в другом ресурсе: элементы копируются в ресурс контейнера
+        const std::pmr::string source("a string long enough to leave the small buffer", std::pmr::new_delete_resource());
+        pmr::Container<std::pmr::string> strings{std::pmr::polymorphic_allocator<std::pmr::string>(&resource)};
+        strings.push_back(source);
+        strings.push_back(std::pmr::string(source, std::pmr::new_delete_resource()).append("!"));
+        EXPECT_EQ(strings.size(), 2);
+        EXPECT_EQ(strings.front().get_allocator().resource(), &resource);
+        EXPECT_EQ(strings.back().get_allocator().resource(), &resource);
+
+        pmr::ForwardContainer<int> forward{std::pmr::polymorphic_allocator<int>(&resource)};
+        forward.push_back(2);
+        forward.push_back(1);
+        EXPECT_EQ(forward.front(), 1);
+    }
+    std::pmr::set_default_resource(previous);
+}
+
+TEST(PmrContainerTest, CopiesUseTheirOwnResource) {
+    std::pmr::unsynchronized_pool_resource first;
+    std::pmr::unsynchronized_pool_resource second;
+    pmr::Container<std::pmr::string> a{std::pmr::polymorphic_allocator<std::pmr::string>(&first)};
+    for (int i = 0; i < 50; ++i) {
+        a.push_back(std::pmr::string(40, static_cast<char>('a' + i % 26)));
+    }
+    pmr::Container<std::pmr::string> b{std::pmr::polymorphic_allocator<std::pmr::string>(&second)};
+    b = a; // polymorphic_allocator не распространяется при присваивании
+    EXPECT_EQ(b.get_allocator().resource(), &second);
+    EXPECT_TRUE(std::equal(a.begin(), a.end(), b.begin(), b.end()));
+    for (const auto& s : b) {
+        ASSERT_EQ(s.get_allocator().resource(), &second);
+    }
+
+    pmr::Container<std::pmr::string> c(std::move(a), std::pmr::polymorphic_allocator<std::pmr::string>(&second));
+    EXPECT_EQ(c.size(), 50);
+    EXPECT_EQ(c.front().get_allocator().resource(), &second);
+}
+
+TEST(ContainerBoundsTest, MatchMultisetWithDuplicates) {
+    Container<int> c;
+    CachedLinkContainer<int> cached;
+    std::multiset<int> reference;
+    std::mt19937 gen(21);
+    for (int i = 0; i < 3000; ++i) {
+        const int value = static_cast<int>(gen() % 500) * 2; // Только четные, с повторами
+        c.insert(c.end(), value);
+        cached.insert(cached.end(), value);
+        reference.insert(value);
+    }
+
+    const Container<int>& const_c = c;
+    for (int key = -3; key <= 1003; ++key) {
+        const auto expected_lower = std::distance(reference.begin(), reference.lower_bound(key));
+        const auto expected_upper = std::distance(reference.begin(), reference.upper_bound(key));
+        ASSERT_EQ(std::distance(c.begin(), c.lower_bound(key)), expected_lower) << key;
+        ASSERT_EQ(std::distance(c.begin(), c.upper_bound(key)), expected_upper) << key;
+        ASSERT_EQ(std::distance(cached.begin(), cached.lower_bound(key)), expected_lower) << key;
+        ASSERT_EQ(std::distance(cached.begin(), cached.upper_bound(key)), expected_upper) << key;
+
+        const auto [first, last] = const_c.equal_range(key);
+        ASSERT_EQ(std::distance(first, last), static_cast<std::ptrdiff_t>(reference.count(key))) << key;
+        for (auto it = first; it != last; ++it) {
+            ASSERT_EQ(*it, key);
+        }
+    }
+    EXPECT_EQ(c.lower_bound(2000), c.end());
+    EXPECT_EQ(c.upper_bound(-1), c.begin());
+}
+
+TEST(ContainerBoundsTest, TimeWindowOverSplitKey) {
+    SplitKeyContainer<Record, TimestampOf> c;
+    for (std::int64_t ts = 0; ts < 1000; ts += 10) {
+        c.push_back(make_record(ts));
+    }
+    // Записи с timestamp в [255, 500]
+    auto first = c.lower_bound(255);
+    auto last = c.upper_bound(500);
+    std::vector<std::int64_t> window;
+    for (auto it = first; it != last; ++it) {
+        window.push_back(it->timestamp);
+    }
+    ASSERT_EQ(window.size(), 25);
+    EXPECT_EQ(window.front(), 260);
+    EXPECT_EQ(window.back(), 500);
+
+    auto strings = Container<std::string>{"b", "a", "c", "b"};
+    auto [begin_b, end_b] = strings.equal_range("b");
+    EXPECT_EQ(std::distance(begin_b, end_b), 2);
+    EXPECT_EQ(*end_b, "c");
+}
+
+namespace {
+
+// Компаратор с состоянием: порядок по модулю, направление задается при создании.
+struct ModuloOrder {
+    int modulus = 10;
+    bool operator()(int a, int b) const {
+        return a % modulus < b % modulus;
+    }
+};
+
+// Ключ, считающий свои конструирования, сравнимый с int.
+struct CountedKey {
+    static inline int constructed = 0;
+    int value;
+    explicit CountedKey(int v) : value(v) { ++constructed; }
+    CountedKey(const CountedKey& other) : value(other.value) { ++constructed; }
+    CountedKey& operator=(const CountedKey&) = default;
+    friend bool operator<(const CountedKey& a, const CountedKey& b) { return a.value < b.value; }
+    friend bool operator<(const CountedKey& a, int b) { return a.value < b; }
+    friend bool operator<(int a, const CountedKey& b) { return a < b.value; }
+};
+
+} // namespace
+
+TEST(ContainerCompareTest, CustomAndStatefulComparators) {
+    Container<int, std::allocator<int>, true, ValueKey<int>, std::greater<>> descending = {3, 1, 4, 1, 5, 9, 2, 6};
+    EXPECT_EQ(std::vector<int>(descending.begin(), descending.end()), (std::vector<int>{9, 6, 5, 4, 3, 2, 1, 1}));
+    EXPECT_TRUE(descending.contains(4));
+    EXPECT_EQ(*descending.lower_bound(7), 6); // Первый не "меньший" 7 в порядке убывания
+    EXPECT_EQ(std::distance(descending.lower_bound(1), descending.upper_bound(1)), 2);
+
+    using ModuloContainer = Container<int, std::allocator<int>, true, ValueKey<int>, ModuloOrder>;
+    ModuloContainer by_last_digit(ModuloOrder{10});
+    for (int value : {25, 13, 7, 30, 41}) {
+        by_last_digit.push_back(value);
+    }
+    EXPECT_EQ(std::vector<int>(by_last_digit.begin(), by_last_digit.end()), (std::vector<int>{30, 41, 13, 25, 7}));
+    EXPECT_TRUE(by_last_digit.contains(3)); // Эквивалентен 13
+    EXPECT_FALSE(by_last_digit.contains(9));
+
+    ModuloContainer by_mod_three({5, 6, 7}, ModuloOrder{3});
+    EXPECT_EQ(by_mod_three.key_comp().modulus, 3);
+    by_mod_three.swap(by_last_digit);
+    EXPECT_EQ(by_mod_three.key_comp().modulus, 10);
+    EXPECT_EQ(by_last_digit.key_comp().modulus, 3);
+    ModuloContainer copy = by_last_digit;
+    EXPECT_EQ(copy.key_comp().modulus, 3);
+    EXPECT_EQ(copy.front(), 6);
+
+    // Пустой компаратор не увеличивает контейнер
+    EXPECT_EQ(sizeof(Container<int>), (sizeof(Container<int, std::allocator<int>, true, ValueKey<int>, std::greater<>>)));
+}
+
+TEST(ContainerCompareTest, StringsWithCustomComparator) {
+    // ValueKey<std::string> хранит префиксы в порядке operator<; с другим Compare
+    // контейнер сам берет PlainValueKey
+    Container<std::string, std::allocator<std::string>, true, ValueKey<std::string>, std::greater<>> descending =
+        {"bravo", "alpha", "a string longer than eight bytes", "charlie"};
+    EXPECT_EQ(descending.front(), "charlie");
+    EXPECT_EQ(descending.back(), "a string longer than eight bytes");
+    EXPECT_TRUE(descending.contains(std::string_view("alpha")));
+    EXPECT_EQ(*descending.lower_bound("b"), "alpha");
+
+    auto shorter_first = [](const std::string& a, const std::string& b) {
+        return a.size() != b.size() ? a.size() < b.size() : a < b;
+    };
+    Container<std::string, std::allocator<std::string>, true, PlainValueKey<std::string>, decltype(shorter_first)>
+        by_length(shorter_first);
+    for (const char* word : {"ccc", "a", "bb", "aa"}) {
+        by_length.push_back(word);
+    }
+    EXPECT_EQ(std::vector<std::string>(by_length.begin(), by_length.end()),
+              (std::vector<std::string>{"a", "aa", "bb", "ccc"}));
+    EXPECT_TRUE(by_length.contains("bb"));
+}
+
+TEST(ContainerCompareTest, TransparentLookupBuildsNoKeys) {
+    Container<std::string> strings = {"delta", "alpha", "charlie", "bravo", "a string longer than eight bytes"};
+    const std::string_view view = "charlie";
+    EXPECT_TRUE(strings.contains(view));
+    EXPECT_TRUE(strings.contains("alpha"));
+    EXPECT_FALSE(strings.contains("alph"));
+    EXPECT_EQ(*strings.find(std::string_view("a string longer than eight bytes")), "a string longer than eight bytes");
+    EXPECT_EQ(*strings.lower_bound("b"), "bravo");
+    EXPECT_EQ(*strings.upper_bound(std::string_view("charlie")), "delta");
+    EXPECT_EQ(strings.find("zulu"), strings.end());
+
+    // Для остальных типов поиск по другим ключам включается прозрачным Compare
+    Container<CountedKey, std::allocator<CountedKey>, true, ValueKey<CountedKey>, std::less<>> keys;
+    for (int i = 0; i < 100; ++i) {
+        keys.push_back(CountedKey(i * 2));
+    }
+    CountedKey::constructed = 0;
+    EXPECT_TRUE(keys.contains(42));
+    EXPECT_FALSE(keys.contains(43));
+    EXPECT_EQ(keys.lower_bound(43)->value, 44);
+    EXPECT_EQ(std::distance(keys.equal_range(10).first, keys.equal_range(10).second), 1);
+    EXPECT_EQ(CountedKey::constructed, 0);
+}
+
+namespace {
+
+// Все виды поиска принимают K (или K приводится к key_type).
+template <typename C, typename K>
+concept FindsBy = requires(C& c, const K& key) {
+    c.find(key);
+    c.contains(key);
+    c.lower_bound(key);
+    c.upper_bound(key);
+    c.equal_range(key);
+    c.cursor().seek(key);
+};
+
+} // namespace
+
+TEST(ContainerCompareTest, LookupKeysMustBeComparable) {
+    // По умолчанию std::less<int>: 2.5 приводится к int, как в std::set<int>
+    Container<int> ints = {1, 2, 3};
+    ASSERT_NE(ints.find(2.5), ints.end());
+    EXPECT_EQ(*ints.find(2.5), 2);
+    Container<int, std::allocator<int>, true, ValueKey<int>, std::less<>> transparent = {1, 2, 3};
+    EXPECT_EQ(transparent.find(2.5), transparent.end());
+
+    // Несравнимый ключ снимает шаблонные перегрузки с разрешения, а не ломает их тело
+    using Strings = Container<std::string>;
+    static_assert(FindsBy<Strings, std::string_view> && FindsBy<Strings, const char*>);
+    static_assert(!FindsBy<Strings, int> && !FindsBy<Strings, double>);
+    using Plain = Container<std::string, std::allocator<std::string>, true, PlainValueKey<std::string>>;
+    static_assert(!FindsBy<Plain, int>);
+    using Transparent = Container<std::string, std::allocator<std::string>, true, PlainValueKey<std::string>, std::less<>>;
+    static_assert(FindsBy<Transparent, std::string_view> && !FindsBy<Transparent, int>);
+}
+
+namespace {
+
+struct CountingLess {
+    std::size_t* calls;
+    bool operator()(int a, int b) const {
+        ++*calls;
+        return a < b;
+    }
+};
+
+// Запоминает размер каждого живого блока: по размеру блока узла видна высота его башни.
+template <typename T>
+struct BlockSizeAllocator {
+    using value_type = T;
+
+    std::map<std::uintptr_t, std::size_t>* blocks;
+
+    explicit BlockSizeAllocator(std::map<std::uintptr_t, std::size_t>* b) : blocks(b) {}
+
+    template <typename U>
+    BlockSizeAllocator(const BlockSizeAllocator<U>& other) noexcept : blocks(other.blocks) {}
+
+    T* allocate(std::size_t n) {
+        T* p = std::allocator<T>().allocate(n);
+        (*blocks)[reinterpret_cast<std::uintptr_t>(p)] = n * sizeof(T);
+        return p;
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        blocks->erase(reinterpret_cast<std::uintptr_t>(p));
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    // Размер блока, внутри которого лежит object.
+    std::size_t block_of(const void* object) const {
+        auto it = blocks->upper_bound(reinterpret_cast<std::uintptr_t>(object));
+        return std::prev(it)->second;
+    }
+
+    template <typename U>
+    bool operator==(const BlockSizeAllocator<U>& other) const noexcept { return blocks == other.blocks; }
+
+    template <typename U>
+    bool operator!=(const BlockSizeAllocator<U>& other) const noexcept { return blocks != other.blocks; }
+};
+
+} // namespace
+
+TEST(ContainerHintTest, AnyHintKeepsOrder) {
+    Container<int> c;
+    ForwardContainer<int> forward;
+    std::multiset<int> reference;
+    std::mt19937 gen(23);
+    for (int i = 0; i < 5000; ++i) {
+        const int value = static_cast<int>(gen() % 2000);
+        // Подсказки: точная, случайная, begin(), end()
+        Container<int>::const_iterator hint;
+        switch (i % 4) {
+        case 0: hint = c.lower_bound(value); break;
+        case 1: hint = c.lower_bound(static_cast<int>(gen() % 2000)); break;
+        case 2: hint = c.begin(); break;
+        default: hint = c.end(); break;
+        }
+        auto it = c.insert(hint, value);
+        ASSERT_EQ(*it, value);
+        forward.insert(forward.begin(), value);
+        reference.insert(value);
+    }
+    EXPECT_TRUE(std::equal(c.begin(), c.end(), reference.begin(), reference.end()));
+    EXPECT_TRUE(std::equal(forward.begin(), forward.end(), reference.begin(), reference.end()));
+    for (int value = 0; value < 2000; value += 7) {
+        ASSERT_EQ(std::distance(c.lower_bound(value), c.upper_bound(value)),
+                  static_cast<std::ptrdiff_t>(reference.count(value)));
+    }
+}
+
+TEST(ContainerHintTest, LocalInsertsCostFewComparisons) {
+    std::size_t calls = 0;
+    using CountingContainer = Container<int, std::allocator<int>, true, ValueKey<int>, CountingLess>;
+    CountingContainer c(CountingLess{&calls});
+    constexpr int count = 50000;
+    for (int i = 0; i < count; ++i) {
+        c.insert(c.end(), i * 2);
+    }
+
+    // Каждая вставка рядом с предыдущей: нечетные числа по возрастанию
+    calls = 0;
+    auto hint = c.cbegin();
+    for (int i = 0; i < count; ++i) {
+        hint = c.insert(hint, i * 2 + 1);
+    }
+    const double per_insert = static_cast<double>(calls) / count;
+    EXPECT_LT(per_insert, 8.0);
+
+    // Для сравнения: та же вставка без подсказки идет сверху
+    calls = 0;
+    c.insert(c.begin(), count);
+    EXPECT_GT(calls, 20u);
+
+    std::vector<int> expected(2 * count);
+    std::iota(expected.begin(), expected.end(), 0);
+    expected.insert(expected.begin() + count, count);
+    EXPECT_TRUE(std::equal(c.begin(), c.end(), expected.begin(), expected.end()));
+}
+
+TEST(ContainerHintTest, TallNodesInSparseAreaStayCheap) {
+    // В середине списка остаются только узлы уровня 0, и в эту область вставляются
+    // значения по убыванию с точной подсказкой. Поиск предшественников шагами
+    // назад по prev проходил бы для каждой высокой башни всю область слева.
+    std::map<std::uintptr_t, std::size_t> blocks;
+    using Tracked = Container<int, BlockSizeAllocator<int>, true, ValueKey<int>, CountingLess>;
+    std::size_t calls = 0;
+    constexpr int count = 60000;
+    constexpr int sparse_begin = 4 * 10000;
+    constexpr int sparse_end = 4 * 50000;
+
+    Tracked c(CountingLess{&calls}, BlockSizeAllocator<int>(&blocks));
+    c.set_node_cache_limit(0); // Высоты новых узлов - только от генератора
+    for (int i = 0; i < count; ++i) {
+        c.push_back(4 * i);
+    }
+    const BlockSizeAllocator<int> alloc = c.get_allocator();
+    std::size_t short_block = std::numeric_limits<std::size_t>::max();
+    for (const int& value : c) {
+        short_block = std::min(short_block, alloc.block_of(&value));
+    }
+    auto cursor = c.cursor(); // erase() искал бы сверху через уже разреженную область
+    for (auto it = cursor.seek(sparse_begin); *it < sparse_end;) {
+        it = alloc.block_of(&*it) > short_block ? cursor.erase(it) : std::next(it);
+    }
+
+    // Подсказка всегда точная: первый элемент больше вставляемого
+    calls = 0;
+    container_prev_steps = 0;
+    auto hint = c.lower_bound(sparse_end);
+    for (int value = sparse_end - 2; value > sparse_begin; value -= 4) {
+        while (*std::prev(hint) > value) {
+            --hint;
+        }
+        hint = c.insert(hint, value);
+    }
+    const double inserted = (sparse_end - sparse_begin) / 4;
+    // Высокой башне нужен спуск сверху, остальным хватает prev(hint)
+    EXPECT_LT(static_cast<double>(calls) / inserted, 40.0);
+    // Шагов назад не больше current_max_level на вставку; без этого ограничения
+    // область в 20000 узлов проходилась бы тысячи раз
+    EXPECT_LT(static_cast<double>(container_prev_steps) / inserted, 10.0);
+
+    EXPECT_TRUE(std::is_sorted(c.begin(), c.end()));
+    for (int value = sparse_begin + 2; value < sparse_end; value += 4 * 250) {
+        ASSERT_EQ(*c.lower_bound(value), value);
+    }
+}
+
+TEST(ContainerHintTest, HintsRightOfPositionCostFewComparisons) {
+    std::size_t calls = 0;
+    using CountingContainer = Container<int, std::allocator<int>, true, ValueKey<int>, CountingLess>;
+    CountingContainer c(CountingLess{&calls});
+    constexpr int count = 50000;
+    for (int i = 0; i < count; ++i) {
+        c.push_back(i * 2);
+    }
+
+    // Нечетные числа по убыванию: подсказка (предыдущий вставленный) на два узла правее позиции
+    calls = 0;
+    container_prev_steps = 0;
+    auto hint = c.cend();
+    for (int i = count - 1; i >= 0; --i) {
+        hint = c.insert(hint, i * 2 + 1);
+    }
+    EXPECT_LT(static_cast<double>(calls) / count, 12.0);
+    EXPECT_LT(static_cast<double>(container_prev_steps) / count, 8.0);
+
+    std::vector<int> expected(2 * count);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_TRUE(std::equal(c.begin(), c.end(), expected.begin(), expected.end()));
+}
+
+TEST(ContainerHintTest, RangeInsertChainsHints) {
+    std::size_t calls = 0;
+    using CountingContainer = Container<int, std::allocator<int>, true, ValueKey<int>, CountingLess>;
+    CountingContainer c(CountingLess{&calls});
+    constexpr int count = 50000;
+    for (int i = 0; i < count; ++i) {
+        c.push_back(i * 2);
+    }
+    std::vector<int> odd(count);
+    for (int i = 0; i < count; ++i) {
+        odd[i] = i * 2 + 1;
+    }
+
+    // Каждый элемент ищется от предыдущего вставленного, а не сверху
+    calls = 0;
+    auto first = c.insert(c.cbegin(), odd.begin(), odd.end());
+    EXPECT_EQ(*first, 1);
+    EXPECT_LT(static_cast<double>(calls) / count, 8.0);
+
+    calls = 0;
+    first = c.insert(c.lower_bound(500), 100, 499);
+    EXPECT_EQ(*first, 499);
+    EXPECT_LT(calls, 100u * 10); // Сверху вышло бы около 34 на вставку
+    EXPECT_EQ(std::distance(c.lower_bound(499), c.upper_bound(499)), 101);
+
+    first = c.insert(c.cend(), {-3, -2, -1});
+    EXPECT_EQ(*first, -3);
+    EXPECT_EQ(c.front(), -3);
+    EXPECT_TRUE(std::is_sorted(c.begin(), c.end()));
+    EXPECT_EQ(c.size(), static_cast<std::size_t>(2 * count + 103));
+}
+
+TEST(ContainerNodeCacheTest, CachedTallNodesDoNotRaiseNewHeights) {
+    std::map<std::uintptr_t, std::size_t> blocks;
+    using Tracked = Container<int, BlockSizeAllocator<int>>;
+    Tracked c{BlockSizeAllocator<int>(&blocks)};
+    constexpr int count = 4000;
+    c.set_node_cache_limit(count);
+    for (int i = 0; i < count; ++i) {
+        c.push_back(2 * i);
+    }
+    const BlockSizeAllocator<int> alloc = c.get_allocator();
+    std::size_t short_block = std::numeric_limits<std::size_t>::max();
+    for (const int& value : c) {
+        short_block = std::min(short_block, alloc.block_of(&value));
+    }
+    // В кэше остаются только блоки высоких башен
+    for (auto it = c.begin(); it != c.end();) {
+        it = alloc.block_of(&*it) > short_block ? c.erase(it) : std::next(it);
+    }
+    for (int i = 0; i < count; ++i) {
+        c.insert(c.end(), 2 * i + 1);
+    }
+    std::size_t short_nodes = 0;
+    for (auto it = c.begin(); it != c.end(); ++it) {
+        if (*it % 2 == 1 && alloc.block_of(&*it) == short_block) {
+            short_nodes++;
+        }
+    }
+    // Половина новых узлов - нулевой высоты, как без кэша (отклонение ~30)
+    EXPECT_GT(short_nodes, count / 2 - 300);
+    EXPECT_LT(short_nodes, count / 2 + 300);
+}
+
+TEST(ContainerAppendTest, MonotonicPushesSkipTheSearch) {
+    std::size_t calls = 0;
+    using CountingContainer = Container<int, std::allocator<int>, true, ValueKey<int>, CountingLess>;
+    CountingContainer c(CountingLess{&calls});
+    for (int i = 0; i < 10000; ++i) {
+        c.push_back(i);
+    }
+    EXPECT_LE(calls, 10000u); // Одно сравнение с back() на вставку
+    calls = 0;
+    for (int i = -1; i >= -10000; --i) {
+        c.push_front(i);
+    }
+    EXPECT_LE(calls, 10000u);
+    EXPECT_EQ(c.size(), 20000);
+    EXPECT_EQ(c.front(), -10000);
+    EXPECT_EQ(c.back(), 9999);
+
+    std::vector<int> expected(20000);
+    std::iota(expected.begin(), expected.end(), -10000);
+    EXPECT_TRUE(std::equal(c.begin(), c.end(), expected.begin(), expected.end()));
+    for (int value = -10000; value < 10000; value += 97) {
+        ASSERT_TRUE(c.contains(value));
+    }
+}
+
+TEST(ContainerAppendTest, TailsFollowErasesAndRelayout) {
+    ForwardContainer<int> forward;
+    Container<int> c;
+    for (int i = 0; i < 1000; ++i) {
+        forward.push_back(i);
+        c.push_back(i);
+    }
+    for (int i = 0; i < 300; ++i) {
+        forward.pop_back(); // Хвосты уровней откатываются к предшественникам
+        c.erase(c.find(999 - i));
+    }
+    EXPECT_EQ(forward.back(), 699);
+    EXPECT_EQ(c.back(), 699);
+
+    c.defragment();
+    c.push_back(699); // Равный back() встает после него
+    c.push_back(700);
+    c.push_back(5);   // Меньше back(): обычная вставка
+    forward.push_back(700);
+    EXPECT_EQ(c.back(), 700);
+    EXPECT_EQ(forward.back(), 700);
+    EXPECT_EQ(std::distance(c.lower_bound(699), c.upper_bound(699)), 2);
+    EXPECT_EQ(std::distance(c.lower_bound(5), c.upper_bound(5)), 2);
+    EXPECT_TRUE(std::is_sorted(c.begin(), c.end()));
+
+    c.clear();
+    c.push_back(1);
+    EXPECT_EQ(c.back(), 1);
+    Container<int> moved = std::move(c);
+    moved.push_back(2);
+    EXPECT_EQ(moved.back(), 2);
+    EXPECT_EQ(moved.size(), 2);
+}
+
+TEST(ContainerCursorTest, SortedBatchCostsFewComparisons) {
+    std::size_t calls = 0;
+    using CountingContainer = Container<int, std::allocator<int>, true, ValueKey<int>, CountingLess>;
+    CountingContainer c(CountingLess{&calls});
+    for (int i = 0; i < 20000; i += 2) {
+        c.push_back(i);
+    }
+
+    calls = 0;
+    auto cursor = c.cursor();
+    std::size_t found = 0;
+    for (int key = 0; key < 20000; ++key) {
+        found += cursor.contains(key) ? 1 : 0;
+    }
+    EXPECT_EQ(found, 10000u);
+    EXPECT_LE(calls, 20000u * 10); // Поиск сверху тратит около 28 сравнений на ключ
+
+    // Ключ меньше прошлого - поиск сверху, результат тот же
+    EXPECT_EQ(*cursor.seek(7), 8);
+    EXPECT_EQ(*cursor.seek(-1), 0);
+    EXPECT_EQ(cursor.seek(20000), c.end());
+    EXPECT_EQ(cursor.find(3), c.end());
+}
+
+TEST(ContainerCursorTest, MergeInsertAndEraseMatchMultiset) {
+    Container<int> c;
+    ForwardContainer<int> forward;
+    std::multiset<int> expected;
+    for (int i = 0; i < 3000; i += 3) {
+        c.push_back(i);
+        forward.push_back(i);
+        expected.insert(i);
+    }
+
+    // Слияние отсортированной серии с дубликатами
+    auto cursor = c.cursor();
+    auto forward_cursor = forward.cursor();
+    for (int i = 0; i < 3000; i += 2) {
+        EXPECT_EQ(*cursor.insert(i), i);
+        forward_cursor.insert(i);
+        expected.insert(i);
+    }
+    // Назад и снова вперед
+    cursor.insert(-5);
+    cursor.insert(5000);
+    expected.insert(-5);
+    expected.insert(5000);
+    ASSERT_EQ(c.size(), expected.size());
+    EXPECT_TRUE(std::equal(c.begin(), c.end(), expected.begin(), expected.end()));
+
+    // Удаление всех кратных 5, включая дубликаты
+    for (auto it = cursor.seek(0); it != c.end();) {
+        const int value = *it;
+        if (value % 5 == 0) {
+            it = cursor.erase(it);
+            expected.erase(expected.find(value));
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = forward_cursor.seek(1000); it != forward.end() && *it < 2000;) {
+        it = forward_cursor.erase(it);
+    }
+    ASSERT_EQ(c.size(), expected.size());
+    EXPECT_TRUE(std::equal(c.begin(), c.end(), expected.begin(), expected.end()));
+    EXPECT_TRUE(std::is_sorted(forward.begin(), forward.end()));
+    EXPECT_EQ(forward.lower_bound(1000), forward.lower_bound(2000));
+    EXPECT_EQ(c.back(), *expected.rbegin());
+
+    // Чужие изменения - reset() и дальше как обычно
+    c.clear();
+    cursor.reset();
+    for (int i = 10; i > 0; --i) {
+        cursor.insert(i);
+    }
+    EXPECT_EQ(c.front(), 1);
+    EXPECT_EQ(c.back(), 10);
+    EXPECT_EQ(*cursor.find(4), 4);
+    c.erase(c.find(4));
+    cursor.reset();
+    EXPECT_EQ(*cursor.seek(4), 5);
+}